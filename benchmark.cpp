@@ -0,0 +1,1967 @@
+// Замеры производительности списков.
+//
+// Сборка: g++ -std=c++17 -O2 -pthread -I. benchmark.cpp -o benchmark
+// С Google Benchmark (если установлен): добавить -DSLL_USE_GOOGLE_BENCHMARK -lbenchmark
+//
+// Параметры:
+//   --suite=containers,unrolled,...  наборы замеров через запятую (по умолчанию все)
+//   --max-size=N                     наибольший размер контейнера (по умолчанию 1000000, для 1e7 указать явно)
+//   --filter=TEXT                    только замеры, в имени или контейнере которых есть TEXT
+//   --format=csv|json                формат вывода (по умолчанию csv)
+//
+// Для каждого замера выводятся: ns_per_op, allocs_per_op (вызовы operator new на операцию)
+// и bytes_per_element (живые байты кучи на элемент после построения вместе с накладными расходами распределителя;
+// только для замеров построения)
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <forward_list>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifdef SLL_USE_GOOGLE_BENCHMARK
+#include <benchmark/benchmark.h>
+#endif
+
+#include "concurrent_single_linked_list.h"
+#include "fine_grained_single_linked_list.h"
+#include "hashed_single_linked_list.h"
+#include "index_linked_list.h"
+#include "lru_cache.h"
+#include "mapped_single_linked_list.h"
+#include "parallel_list_algorithms.h"
+#include "persistent_single_linked_list.h"
+#include "pool_allocator.h"
+#include "positional_single_linked_list.h"
+#include "single_linked_list.h"
+#include "small_single_linked_list.h"
+#include "sorted_single_linked_list.h"
+#include "thread_node_cache.h"
+#include "unrolled_linked_list.h"
+
+
+// ---------- Подсчёт аллокаций ----------
+
+// Счётчики глобального operator new.
+// Живые байты — сколько блоки действительно занимают в куче, вместе с накладными расходами распределителя:
+// в glibc это полезный размер блока (malloc_usable_size) плюс служебное слово перед ним.
+// На других платформах перед каждым блоком хранится запрошенный размер, и учитывается он
+struct AllocationCounters {
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> live_bytes{0};
+};
+
+AllocationCounters g_allocations;
+
+#ifdef __GLIBC__
+
+namespace {
+size_t HeapFootprint(void* block) noexcept {
+    return malloc_usable_size(block) + sizeof(size_t);
+}
+}
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size ? size : 1);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    g_allocations.count.fetch_add(1, std::memory_order_relaxed);
+    g_allocations.live_bytes.fetch_add(HeapFootprint(block), std::memory_order_relaxed);
+    return block;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) {
+        return;
+    }
+    g_allocations.live_bytes.fetch_sub(HeapFootprint(p), std::memory_order_relaxed);
+    std::free(p);
+}
+
+#else
+
+namespace {
+constexpr size_t kAllocationHeader = alignof(std::max_align_t);
+}
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size + kAllocationHeader);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    g_allocations.count.fetch_add(1, std::memory_order_relaxed);
+    g_allocations.live_bytes.fetch_add(size, std::memory_order_relaxed);
+    return static_cast<char*>(block) + kAllocationHeader;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) {
+        return;
+    }
+    void* block = static_cast<char*>(p) - kAllocationHeader;
+    g_allocations.live_bytes.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+#endif
+
+void operator delete(void* p, size_t) noexcept {
+    ::operator delete(p);
+}
+
+
+// ---------- Каркас замеров ----------
+
+// Результат пишется сюда, чтобы компилятор не выбросил измеряемый код
+volatile long long g_sink = 0;
+
+// Один замер. prepare и cleanup не входят во время, run — входит.
+// ops — сколько операций выполняет один вызов run (на них делится время и число аллокаций)
+struct BenchCase {
+    std::string benchmark;
+    std::string container;
+    std::string type;
+    size_t size = 0;
+    size_t ops = 1;
+    std::function<void()> prepare = [] {};
+    std::function<void()> run;
+    std::function<void()> cleanup = [] {};
+    // Вызывается один раз после всех повторений
+    std::function<void()> teardown = [] {};
+    // Замерять ли живые байты на элемент после run (для замеров построения)
+    bool report_footprint = false;
+};
+
+struct BenchResult {
+    double ns_per_op = 0;
+    double allocs_per_op = 0;
+    std::optional<double> bytes_per_element;
+};
+
+struct BenchOptions {
+    std::vector<std::string> suites;
+    size_t max_size = 1000000;
+    std::string filter;
+    bool json = false;
+
+    bool HasSuite(const std::string& name) const {
+        return suites.empty() || std::find(suites.begin(), suites.end(), name) != suites.end();
+    }
+
+    // Степени десяти от 100 до max_size
+    std::vector<size_t> Sizes() const {
+        std::vector<size_t> sizes;
+        for (size_t n = 100; n <= max_size; n *= 10) {
+            sizes.push_back(n);
+        }
+        return sizes;
+    }
+};
+
+// Повторяет замер, пока не наберётся хотя бы kMinRepeats повторений и kMinTotalNs времени. Берётся лучшее время
+BenchResult RunCase(const BenchCase& bench_case) {
+    constexpr int kMinRepeats = 3;
+    constexpr int kMaxRepeats = 1000;
+    constexpr double kMinTotalNs = 5e7;
+
+    BenchResult result;
+    double total_ns = 0;
+    for (int r = 0; r < kMaxRepeats && (r < kMinRepeats || total_ns < kMinTotalNs); ++r) {
+        bench_case.prepare();
+        const size_t allocs_before = g_allocations.count.load();
+        const size_t live_before = g_allocations.live_bytes.load();
+        const auto start = std::chrono::steady_clock::now();
+        bench_case.run();
+        const auto finish = std::chrono::steady_clock::now();
+        const size_t allocs = g_allocations.count.load() - allocs_before;
+        const long long live_delta = static_cast<long long>(g_allocations.live_bytes.load()) - static_cast<long long>(live_before);
+        bench_case.cleanup();
+
+        const double ns = std::chrono::duration<double, std::nano>(finish - start).count();
+        total_ns += ns;
+        const double ns_per_op = ns / static_cast<double>(bench_case.ops);
+        if (r == 0 || ns_per_op < result.ns_per_op) {
+            result.ns_per_op = ns_per_op;
+        }
+        if (r == 0) {
+            result.allocs_per_op = static_cast<double>(allocs) / static_cast<double>(bench_case.ops);
+            if (bench_case.report_footprint && bench_case.size > 0) {
+                result.bytes_per_element = static_cast<double>(live_delta) / static_cast<double>(bench_case.size);
+            }
+        }
+    }
+    return result;
+}
+
+class Reporter {
+public:
+    explicit Reporter(bool json) : json_(json) {}
+
+    void Begin() {
+        if (json_) {
+            std::cout << "[\n";
+        } else {
+            std::cout << "benchmark,container,type,size,ns_per_op,allocs_per_op,bytes_per_element\n";
+        }
+    }
+
+    void Report(const BenchCase& c, const BenchResult& r) {
+        if (json_) {
+            std::cout << (first_ ? "" : ",\n") << "  {\"benchmark\": \"" << c.benchmark << "\", \"container\": \"" << c.container
+                      << "\", \"type\": \"" << c.type << "\", \"size\": " << c.size << ", \"ns_per_op\": " << r.ns_per_op
+                      << ", \"allocs_per_op\": " << r.allocs_per_op << ", \"bytes_per_element\": ";
+            if (r.bytes_per_element) {
+                std::cout << *r.bytes_per_element;
+            } else {
+                std::cout << "null";
+            }
+            std::cout << '}';
+        } else {
+            std::cout << c.benchmark << ',' << c.container << ',' << c.type << ',' << c.size << ',' << r.ns_per_op << ','
+                      << r.allocs_per_op << ',';
+            if (r.bytes_per_element) {
+                std::cout << *r.bytes_per_element;
+            }
+            std::cout << '\n';
+        }
+        std::cout.flush();
+        first_ = false;
+    }
+
+    void End() {
+        if (json_) {
+            std::cout << "\n]\n";
+        }
+    }
+
+private:
+    bool json_;
+    bool first_ = true;
+};
+
+
+// ---------- Типы элементов ----------
+
+// Структура на 128 байт — «крупный» элемент
+struct Payload128 {
+    std::array<char, 128> data{};
+};
+
+bool operator==(const Payload128& lhs, const Payload128& rhs) {
+    return std::memcmp(lhs.data.data(), rhs.data.data(), lhs.data.size()) == 0;
+}
+bool operator!=(const Payload128& lhs, const Payload128& rhs) {
+    return !(lhs == rhs);
+}
+bool operator<(const Payload128& lhs, const Payload128& rhs) {
+    return std::memcmp(lhs.data.data(), rhs.data.data(), lhs.data.size()) < 0;
+}
+
+template <typename T>
+T MakeValue(size_t i);
+
+template <>
+int MakeValue<int>(size_t i) {
+    return static_cast<int>(i);
+}
+
+// Строки длиннее буфера SSO, чтобы каждая владела памятью в куче
+template <>
+std::string MakeValue<std::string>(size_t i) {
+    return "element-with-a-long-enough-name-" + std::to_string(i);
+}
+
+template <>
+Payload128 MakeValue<Payload128>(size_t i) {
+    Payload128 payload;
+    std::memcpy(payload.data.data(), &i, sizeof(i));
+    return payload;
+}
+
+long long Consume(int value) {
+    return value;
+}
+long long Consume(const std::string& value) {
+    return static_cast<long long>(value.size());
+}
+long long Consume(const Payload128& value) {
+    return value.data[0];
+}
+
+
+// ---------- Общий интерфейс контейнеров ----------
+
+template <typename C>
+constexpr bool kIsSingleLinkedList = false;
+template <typename T, typename A, typename S>
+constexpr bool kIsSingleLinkedList<SingleLinkedList<T, A, S>> = true;
+
+template <typename T, size_t N>
+constexpr bool kIsSingleLinkedList<SmallSingleLinkedList<T, N>> = true;
+
+template <typename T, typename I>
+constexpr bool kIsSingleLinkedList<IndexLinkedList<T, I>> = true;
+
+template <typename C>
+constexpr bool kIsVector = false;
+template <typename T>
+constexpr bool kIsVector<std::vector<T>> = true;
+
+template <typename C>
+constexpr bool kIsForwardList = false;
+template <typename T>
+constexpr bool kIsForwardList<std::forward_list<T>> = true;
+
+// Вставка в «естественный» конец: в начало для списков, в конец для std::vector
+template <typename C, typename V>
+void PushFront(C& c, V&& value) {
+    if constexpr (kIsSingleLinkedList<C>) {
+        c.PushFront(std::forward<V>(value));
+    } else if constexpr (kIsVector<C>) {
+        c.push_back(std::forward<V>(value));
+    } else {
+        c.push_front(std::forward<V>(value));
+    }
+}
+
+template <typename C>
+C MakeContainer(size_t n) {
+    C c;
+    for (size_t i = 0; i < n; ++i) {
+        PushFront(c, MakeValue<typename C::value_type>(n - i));
+    }
+    return c;
+}
+
+template <typename C>
+void ClearContainer(C& c) {
+    if constexpr (kIsSingleLinkedList<C>) {
+        c.Clear();
+    } else {
+        c.clear();
+    }
+}
+
+// Вставляет новый элемент после каждого существующего: n вставок за один проход
+template <typename C>
+void InsertAfterEach(C& c, const typename C::value_type& value) {
+    if constexpr (kIsSingleLinkedList<C>) {
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            it = c.InsertAfter(it, value);
+        }
+    } else if constexpr (kIsForwardList<C>) {
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            it = c.insert_after(it, value);
+        }
+    } else {
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            it = c.insert(std::next(it), value);
+        }
+    }
+}
+
+// Удаляет каждый второй элемент: n / 2 удалений за один проход
+template <typename C>
+void EraseAfterEach(C& c) {
+    if constexpr (kIsSingleLinkedList<C>) {
+        for (auto it = c.begin(); it != c.end() && std::next(it) != c.end(); ++it) {
+            c.EraseAfter(it);
+        }
+    } else if constexpr (kIsForwardList<C>) {
+        for (auto it = c.begin(); it != c.end() && std::next(it) != c.end(); ++it) {
+            c.erase_after(it);
+        }
+    } else {
+        for (auto it = c.begin(); it != c.end() && std::next(it) != c.end();) {
+            it = c.erase(std::next(it));
+        }
+    }
+}
+
+
+// ---------- Набор containers: SingleLinkedList против стандартных контейнеров ----------
+
+template <typename C>
+void AddContainerCases(std::vector<BenchCase>& cases, const std::string& container, const std::string& type, size_t n) {
+    using T = typename C::value_type;
+    auto state = std::make_shared<std::optional<C>>();
+    auto other = std::make_shared<std::optional<C>>();
+    auto fill = [state, n] { state->emplace(MakeContainer<C>(n)); };
+    auto drop = [state, other] {
+        state->reset();
+        other->reset();
+    };
+    auto base = [&](const std::string& benchmark, size_t ops) {
+        BenchCase c;
+        c.benchmark = benchmark;
+        c.container = container;
+        c.type = type;
+        c.size = n;
+        c.ops = ops;
+        c.cleanup = drop;
+        return c;
+    };
+
+    {
+        // Значения готовятся заранее, чтобы в замер не попадало их создание
+        auto values = std::make_shared<std::vector<T>>();
+        BenchCase c = base("push_front", n);
+        c.prepare = [state, values, n] {
+            state->emplace();
+            values->clear();
+            for (size_t i = 0; i < n; ++i) {
+                values->push_back(MakeValue<T>(i));
+            }
+        };
+        c.run = [state, values] {
+            for (T& value : *values) {
+                PushFront(**state, std::move(value));
+            }
+        };
+        c.cleanup = [drop, values] {
+            values->clear();
+            drop();
+        };
+        c.report_footprint = true;
+        cases.push_back(c);
+    }
+    if constexpr (!kIsVector<C>) {
+        // Для std::vector вставка и удаление в середине квадратичны, поэтому не замеряются
+        const T value = MakeValue<T>(0);
+        BenchCase insert = base("insert_after", n);
+        insert.prepare = fill;
+        insert.run = [state, value] { InsertAfterEach(**state, value); };
+        cases.push_back(insert);
+
+        BenchCase erase = base("erase_after", n / 2);
+        erase.prepare = fill;
+        erase.run = [state] { EraseAfterEach(**state); };
+        cases.push_back(erase);
+    }
+    {
+        BenchCase c = base("clear", n);
+        c.prepare = fill;
+        c.run = [state] { ClearContainer(**state); };
+        cases.push_back(c);
+    }
+    {
+        BenchCase c = base("copy", n);
+        c.prepare = fill;
+        c.run = [state, other] { other->emplace(**state); };
+        cases.push_back(c);
+    }
+    auto fill_two = [state, other, n] {
+        state->emplace(MakeContainer<C>(n));
+        other->emplace(**state);
+    };
+    {
+        BenchCase c = base("equal", n);
+        c.prepare = fill_two;
+        c.run = [state, other] { g_sink = (**state == **other); };
+        cases.push_back(c);
+    }
+    {
+        BenchCase c = base("less", n);
+        c.prepare = fill_two;
+        c.run = [state, other] { g_sink = (**state < **other); };
+        cases.push_back(c);
+    }
+    {
+        BenchCase c = base("iterate", n);
+        c.prepare = fill;
+        c.run = [state] {
+            long long sum = 0;
+            for (const T& value : **state) {
+                sum += Consume(value);
+            }
+            g_sink = sum;
+        };
+        cases.push_back(c);
+    }
+}
+
+template <typename T>
+void AddContainerCasesForType(std::vector<BenchCase>& cases, const std::string& type, size_t n) {
+    AddContainerCases<SingleLinkedList<T>>(cases, "SingleLinkedList", type, n);
+    AddContainerCases<IndexLinkedList<T>>(cases, "IndexLinkedList", type, n);
+    AddContainerCases<std::forward_list<T>>(cases, "std::forward_list", type, n);
+    AddContainerCases<std::list<T>>(cases, "std::list", type, n);
+    AddContainerCases<std::vector<T>>(cases, "std::vector", type, n);
+}
+
+void AddContainerSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        AddContainerCasesForType<int>(cases, "int", n);
+        AddContainerCasesForType<std::string>(cases, "std::string", n);
+        AddContainerCasesForType<Payload128>(cases, "Payload128", n);
+    }
+}
+
+
+// ---------- Набор unrolled: обход UnrolledLinkedList ----------
+
+template <typename List>
+List MakeIntList(size_t n) {
+    List list;
+    for (size_t i = 0; i < n; ++i) {
+        list.PushFront(static_cast<int>(i));
+    }
+    return list;
+}
+
+template <typename C>
+void AddScanCase(std::vector<BenchCase>& cases, const std::string& container, size_t n, std::function<C()> make) {
+    auto state = std::make_shared<std::optional<C>>();
+    BenchCase c;
+    c.benchmark = "scan";
+    c.container = container;
+    c.type = "int";
+    c.size = n;
+    c.ops = n;
+    c.prepare = [state, make] { state->emplace(make()); };
+    c.run = [state] {
+        long long sum = 0;
+        for (auto it = (*state)->begin(); it != (*state)->end(); ++it) {
+            sum += *it;
+        }
+        g_sink = sum;
+    };
+    c.cleanup = [state] { state->reset(); };
+    cases.push_back(c);
+}
+
+template <typename List>
+void AddBuildCase(std::vector<BenchCase>& cases, const std::string& container, size_t n) {
+    auto state = std::make_shared<std::optional<List>>();
+    BenchCase c;
+    c.benchmark = "push_front";
+    c.container = container;
+    c.type = "int";
+    c.size = n;
+    c.ops = n;
+    c.run = [state, n] { state->emplace(MakeIntList<List>(n)); };
+    c.cleanup = [state] { state->reset(); };
+    c.report_footprint = true;
+    cases.push_back(c);
+}
+
+void AddUnrolledSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        AddBuildCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n);
+        AddBuildCase<UnrolledLinkedList<int, 16>>(cases, "UnrolledLinkedList<16>", n);
+        AddBuildCase<UnrolledLinkedList<int, 64>>(cases, "UnrolledLinkedList<64>", n);
+
+        AddScanCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n, [n] { return MakeIntList<SingleLinkedList<int>>(n); });
+        AddScanCase<UnrolledLinkedList<int, 16>>(cases, "UnrolledLinkedList<16>", n,
+                                                 [n] { return MakeIntList<UnrolledLinkedList<int, 16>>(n); });
+        AddScanCase<UnrolledLinkedList<int, 64>>(cases, "UnrolledLinkedList<64>", n,
+                                                 [n] { return MakeIntList<UnrolledLinkedList<int, 64>>(n); });
+        AddScanCase<std::vector<int>>(cases, "std::vector", n, [n] { return std::vector<int>(n, 1); });
+    }
+}
+
+
+// ---------- Набор sort: сортировка случайных чисел ----------
+
+template <typename List>
+void AddSortCase(std::vector<BenchCase>& cases, const std::string& container, std::shared_ptr<const std::vector<int>> values) {
+    auto state = std::make_shared<std::optional<List>>();
+    BenchCase c;
+    c.benchmark = "sort";
+    c.container = container;
+    c.type = "int";
+    c.size = values->size();
+    c.ops = values->size();
+    c.prepare = [state, values] {
+        state->emplace();
+        for (auto it = values->rbegin(); it != values->rend(); ++it) {
+            PushFront(**state, *it);
+        }
+    };
+    c.run = [state] {
+        if constexpr (kIsSingleLinkedList<List>) {
+            (*state)->Sort();
+        } else {
+            (*state)->sort();
+        }
+    };
+    c.cleanup = [state] { state->reset(); };
+    cases.push_back(c);
+}
+
+// Сортировка замеряется на 1e6 и (при --max-size=10000000) на 1e7 элементов
+void AddSortSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    std::mt19937 generator(42);
+    for (size_t n : options.Sizes()) {
+        if (n < 1000000) {
+            continue;
+        }
+        auto values = std::make_shared<std::vector<int>>(n);
+        for (int& value : *values) {
+            value = static_cast<int>(generator());
+        }
+        AddSortCase<SingleLinkedList<int>>(cases, "SingleLinkedList", values);
+        AddSortCase<std::forward_list<int>>(cases, "std::forward_list", values);
+    }
+}
+
+
+// ---------- Набор compact: обход фрагментированного списка до и после Compact ----------
+
+// Сортировка случайных чисел перевешивает узлы, и порядок обхода перестаёт совпадать с порядком в памяти
+template <typename List>
+void FillFragmented(List& list, size_t n) {
+    std::mt19937 generator(7);
+    for (size_t i = 0; i < n; ++i) {
+        list.PushFront(static_cast<int>(generator()));
+    }
+    list.Sort();
+}
+
+template <typename List>
+void AddCompactCases(std::vector<BenchCase>& cases, const std::string& container, size_t n) {
+    auto state = std::make_shared<std::optional<List>>();
+    auto base = [&](const std::string& benchmark) {
+        BenchCase c;
+        c.benchmark = benchmark;
+        c.container = container;
+        c.type = "int";
+        c.size = n;
+        c.ops = n;
+        c.cleanup = [state] { state->reset(); };
+        return c;
+    };
+    auto scan = [state] {
+        long long sum = 0;
+        for (int value : **state) {
+            sum += value;
+        }
+        g_sink = sum;
+    };
+
+    BenchCase fragmented = base("scan_fragmented");
+    fragmented.prepare = [state, n] {
+        state->emplace();
+        FillFragmented(**state, n);
+    };
+    fragmented.run = scan;
+    cases.push_back(fragmented);
+
+    BenchCase compacted = base("scan_compacted");
+    compacted.prepare = [state, n] {
+        state->emplace();
+        FillFragmented(**state, n);
+        (*state)->Compact();
+    };
+    compacted.run = scan;
+    cases.push_back(compacted);
+
+    BenchCase compact = base("compact");
+    compact.prepare = fragmented.prepare;
+    compact.run = [state] { (*state)->Compact(); };
+    cases.push_back(compact);
+}
+
+void AddCompactSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        AddCompactCases<SingleLinkedList<int>>(cases, "SingleLinkedList", n);
+        AddCompactCases<SingleLinkedList<int, PoolAllocator<int>>>(cases, "SingleLinkedList+PoolAllocator", n);
+    }
+}
+
+
+// ---------- Набор small: короткие списки со встроенным буфером ----------
+
+// Строит и разрушает kLists списков по n элементов
+template <typename List>
+void AddSmallCase(std::vector<BenchCase>& cases, const std::string& container, size_t n) {
+    constexpr size_t kLists = 10000;
+    BenchCase c;
+    c.benchmark = "build_destroy";
+    c.container = container;
+    c.type = "int";
+    c.size = n;
+    c.ops = kLists * n;
+    c.run = [n] {
+        long long sum = 0;
+        for (size_t i = 0; i < kLists; ++i) {
+            List list;
+            for (size_t j = 0; j < n; ++j) {
+                PushFront(list, static_cast<int>(j));
+            }
+            sum += *list.begin();
+        }
+        g_sink = sum;
+    };
+    cases.push_back(c);
+}
+
+void AddSmallSuite(std::vector<BenchCase>& cases, const BenchOptions&) {
+    for (size_t n : {2, 4, 8, 16}) {
+        AddSmallCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n);
+        AddSmallCase<SmallSingleLinkedList<int, 8>>(cases, "SmallSingleLinkedList<8>", n);
+        AddSmallCase<std::forward_list<int>>(cases, "std::forward_list", n);
+    }
+}
+
+
+// ---------- Набор reload: загрузка сохранённого списка ----------
+
+// Сравнивает перестроение списка из значений через PushBack, Deserialize из файла и отображение образа в память.
+// Для сравнения с прежним способом замеряется и обход: отображённый список обходится прямо по файлу
+void AddReloadSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        if (n < 10000) {
+            continue;
+        }
+        auto values = std::make_shared<std::vector<int>>();
+        auto path = std::make_shared<std::string>(
+            (std::filesystem::temp_directory_path() / ("sll_reload_" + std::to_string(n) + ".bin")).string());
+        auto loaded = std::make_shared<std::optional<SingleLinkedList<int>>>();
+        auto base = [&](const std::string& benchmark, const std::string& container) {
+            BenchCase c;
+            c.benchmark = benchmark;
+            c.container = container;
+            c.type = "int";
+            c.size = n;
+            c.ops = n;
+            return c;
+        };
+        auto sum_list = [](const auto& list) {
+            long long sum = 0;
+            for (int value : list) {
+                sum += value;
+            }
+            g_sink = sum;
+        };
+
+        BenchCase rebuild = base("reload", "PushBack");
+        rebuild.prepare = [values, path, n] {
+            values->resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                (*values)[i] = static_cast<int>(i);
+            }
+            SingleLinkedList<int> list;
+            for (int value : *values) {
+                list.PushBack(value);
+            }
+            std::ofstream out(*path, std::ios::binary);
+            list.Serialize(out);
+        };
+        rebuild.run = [values, loaded] {
+            loaded->emplace();
+            for (int value : *values) {
+                (*loaded)->PushBack(value);
+            }
+        };
+        rebuild.cleanup = [loaded] { loaded->reset(); };
+        cases.push_back(rebuild);
+
+        BenchCase deserialize = base("reload", "Deserialize");
+        deserialize.run = [path, loaded] {
+            std::ifstream in(*path, std::ios::binary);
+            loaded->emplace(SingleLinkedList<int>::Deserialize(in));
+        };
+        deserialize.cleanup = [loaded] { loaded->reset(); };
+        cases.push_back(deserialize);
+
+        BenchCase mapped = base("reload", "MappedSingleLinkedList");
+        mapped.run = [path] {
+            MappedSingleLinkedList<int> list(*path);
+            g_sink = static_cast<long long>(list.GetSize());
+        };
+        cases.push_back(mapped);
+
+        BenchCase rebuild_scan = base("reload_and_scan", "PushBack");
+        rebuild_scan.run = [values, sum_list] {
+            SingleLinkedList<int> list;
+            for (int value : *values) {
+                list.PushBack(value);
+            }
+            sum_list(list);
+        };
+        cases.push_back(rebuild_scan);
+
+        BenchCase deserialize_scan = base("reload_and_scan", "Deserialize");
+        deserialize_scan.run = [path, sum_list] {
+            std::ifstream in(*path, std::ios::binary);
+            sum_list(SingleLinkedList<int>::Deserialize(in));
+        };
+        cases.push_back(deserialize_scan);
+
+        BenchCase mapped_scan = base("reload_and_scan", "MappedSingleLinkedList");
+        mapped_scan.run = [path, sum_list] { sum_list(MappedSingleLinkedList<int>(*path)); };
+        mapped_scan.teardown = [path] { std::filesystem::remove(*path); };
+        cases.push_back(mapped_scan);
+    }
+}
+
+
+// ---------- Набор persistent: снимки состояния ----------
+
+// Снимок списка из n элементов: глубокая копия SingleLinkedList против новой версии PersistentSingleLinkedList
+// (с одним PushFront, чтобы снимок отличался от исходной версии). Время — на один снимок
+void AddPersistentSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    constexpr size_t kSnapshots = 100;
+    for (size_t n : options.Sizes()) {
+        auto mutable_list = std::make_shared<SingleLinkedList<int>>(MakeIntList<SingleLinkedList<int>>(n));
+        auto persistent = std::make_shared<PersistentSingleLinkedList<int>>();
+        for (size_t i = 0; i < n; ++i) {
+            *persistent = persistent->PushFront(static_cast<int>(i));
+        }
+
+        BenchCase deep;
+        deep.benchmark = "snapshot";
+        deep.container = "SingleLinkedList";
+        deep.type = "int";
+        deep.size = n;
+        deep.ops = kSnapshots;
+        deep.run = [mutable_list] {
+            for (size_t i = 0; i < kSnapshots; ++i) {
+                SingleLinkedList<int> snapshot(*mutable_list);
+                g_sink += static_cast<long long>(snapshot.GetSize());
+            }
+        };
+        cases.push_back(deep);
+
+        BenchCase shared = deep;
+        shared.container = "PersistentSingleLinkedList";
+        shared.run = [persistent] {
+            for (size_t i = 0; i < kSnapshots; ++i) {
+                PersistentSingleLinkedList<int> snapshot = persistent->PushFront(0);
+                g_sink += static_cast<long long>(snapshot.GetSize());
+            }
+        };
+        cases.push_back(shared);
+    }
+}
+
+
+// ---------- Набор index: узлы в общем хранилище с 32-битными ссылками ----------
+
+// Список из n элементов, каждый из которых вставлен после случайного уже имеющегося:
+// порядок обхода не совпадает с порядком выделения узлов, как после долгой работы со вставками в середину
+template <typename List>
+List MakeShuffledIntList(size_t n) {
+    List list;
+    std::vector<typename List::Iterator> positions{list.before_begin()};
+    positions.reserve(n + 1);
+    std::mt19937 generator(42);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t after = std::uniform_int_distribution<size_t>(0, positions.size() - 1)(generator);
+        positions.push_back(list.InsertAfter(positions[after], static_cast<int>(i)));
+    }
+    return list;
+}
+
+void AddIndexSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        AddBuildCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n);
+        AddBuildCase<IndexLinkedList<int>>(cases, "IndexLinkedList", n);
+
+        AddScanCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n, [n] { return MakeIntList<SingleLinkedList<int>>(n); });
+        AddScanCase<IndexLinkedList<int>>(cases, "IndexLinkedList", n, [n] { return MakeIntList<IndexLinkedList<int>>(n); });
+
+        const size_t first = cases.size();
+        AddScanCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n,
+                                           [n] { return MakeShuffledIntList<SingleLinkedList<int>>(n); });
+        AddScanCase<IndexLinkedList<int>>(cases, "IndexLinkedList", n,
+                                          [n] { return MakeShuffledIntList<IndexLinkedList<int>>(n); });
+        for (size_t i = first; i < cases.size(); ++i) {
+            cases[i].benchmark = "scan_shuffled";
+        }
+    }
+}
+
+
+// ---------- Набор reclaim: освобождение больших списков ----------
+
+// Время, за которое вызывающий поток освобождает список из n элементов: Clear() или ClearDeferred().
+// Фоновое уничтожение после ClearDeferred дожидается в cleanup, вне замера
+template <typename List>
+void AddReleaseCase(std::vector<BenchCase>& cases, const std::string& container, const std::string& type, size_t n,
+                    bool deferred) {
+    auto state = std::make_shared<std::optional<List>>();
+    BenchCase c;
+    c.benchmark = deferred ? "clear_deferred" : "clear";
+    c.container = container;
+    c.type = type;
+    c.size = n;
+    c.ops = n;
+    c.prepare = [state, n] { state->emplace(MakeContainer<List>(n)); };
+    if (deferred) {
+        c.run = [state] { (*state)->ClearDeferred(); };
+    } else {
+        c.run = [state] { (*state)->Clear(); };
+    }
+    c.cleanup = [state] {
+        state->reset();
+        ListReclaimer::Default().Drain();
+    };
+    cases.push_back(c);
+}
+
+// Копирующее присваивание списку того же размера
+template <typename List>
+void AddCopyAssignCase(std::vector<BenchCase>& cases, const std::string& container, const std::string& type, size_t n) {
+    auto state = std::make_shared<std::optional<List>>();
+    auto source = std::make_shared<std::optional<List>>();
+    BenchCase c;
+    c.benchmark = "copy_assign";
+    c.container = container;
+    c.type = type;
+    c.size = n;
+    c.ops = n;
+    c.prepare = [state, source, n] {
+        state->emplace(MakeContainer<List>(n));
+        source->emplace(MakeContainer<List>(n));
+    };
+    c.run = [state, source] { **state = **source; };
+    c.cleanup = [state, source] {
+        state->reset();
+        source->reset();
+    };
+    cases.push_back(c);
+}
+
+void AddReclaimSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        AddReleaseCase<SingleLinkedList<int>>(cases, "SingleLinkedList", "int", n, false);
+        AddReleaseCase<SingleLinkedList<int, PoolAllocator<int>>>(cases, "SingleLinkedList+PoolAllocator", "int", n, false);
+        AddReleaseCase<SingleLinkedList<int>>(cases, "SingleLinkedList", "int", n, true);
+        AddReleaseCase<SingleLinkedList<std::string>>(cases, "SingleLinkedList", "std::string", n, false);
+        AddReleaseCase<SingleLinkedList<std::string>>(cases, "SingleLinkedList", "std::string", n, true);
+
+        AddCopyAssignCase<SingleLinkedList<int>>(cases, "SingleLinkedList", "int", n);
+        AddCopyAssignCase<SingleLinkedList<std::string>>(cases, "SingleLinkedList", "std::string", n);
+        AddCopyAssignCase<std::forward_list<int>>(cases, "std::forward_list", "int", n);
+    }
+}
+
+
+// ---------- Набор range: вставка диапазона и копирование ----------
+
+// Вставка n значений из std::vector в пустой контейнер одним вызовом
+template <typename C>
+void AddRangeInsertCase(std::vector<BenchCase>& cases, const std::string& container, size_t n) {
+    auto state = std::make_shared<std::optional<C>>();
+    auto values = std::make_shared<std::vector<int>>(n, 1);
+    BenchCase c;
+    c.benchmark = "insert_range";
+    c.container = container;
+    c.type = "int";
+    c.size = n;
+    c.ops = n;
+    c.prepare = [state] { state->emplace(); };
+    c.run = [state, values] {
+        if constexpr (kIsSingleLinkedList<C>) {
+            (*state)->InsertAfter((*state)->before_begin(), values->begin(), values->end());
+        } else {
+            (*state)->insert_after((*state)->before_begin(), values->begin(), values->end());
+        }
+    };
+    c.cleanup = [state] { state->reset(); };
+    cases.push_back(c);
+}
+
+// Копирующий конструктор
+template <typename C>
+void AddCopyCase(std::vector<BenchCase>& cases, const std::string& container, size_t n) {
+    auto source = std::make_shared<std::optional<C>>();
+    auto copy = std::make_shared<std::optional<C>>();
+    BenchCase c;
+    c.benchmark = "copy";
+    c.container = container;
+    c.type = "int";
+    c.size = n;
+    c.ops = n;
+    c.prepare = [source, n] { source->emplace(MakeContainer<C>(n)); };
+    c.run = [source, copy] { copy->emplace(**source); };
+    c.cleanup = [source, copy] {
+        copy->reset();
+        source->reset();
+    };
+    cases.push_back(c);
+}
+
+void AddRangeSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        AddRangeInsertCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n);
+        AddRangeInsertCase<SingleLinkedList<int, PoolAllocator<int>>>(cases, "SingleLinkedList+PoolAllocator", n);
+        AddRangeInsertCase<std::forward_list<int>>(cases, "std::forward_list", n);
+
+        AddCopyCase<SingleLinkedList<int>>(cases, "SingleLinkedList", n);
+        AddCopyCase<SingleLinkedList<int, PoolAllocator<int>>>(cases, "SingleLinkedList+PoolAllocator", n);
+        AddCopyCase<std::forward_list<int>>(cases, "std::forward_list", n);
+    }
+}
+
+
+// ---------- Набор prefetch: обход фрагментированного списка с предвыборкой ----------
+
+// Имитация заметной обработки элемента (несколько десятков тактов), не зависящей от памяти
+inline long long Work(int value) {
+    unsigned long long x = static_cast<unsigned long long>(value);
+    for (int i = 0; i < 16; ++i) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return static_cast<long long>(x >> 40);
+}
+
+// Один фрагментированный список на все замеры размера n: строится при первом prepare и удаляется в teardown
+void AddPrefetchCases(std::vector<BenchCase>& cases, size_t n) {
+    using List = SingleLinkedList<int>;
+    auto state = std::make_shared<std::optional<List>>();
+    auto add = [&](const std::string& benchmark, std::function<void(const List&)> body) {
+        BenchCase c;
+        c.benchmark = benchmark;
+        c.container = "SingleLinkedList";
+        c.type = "int";
+        c.size = n;
+        c.ops = n;
+        c.prepare = [state, n] {
+            if (!*state) {
+                state->emplace();
+                FillFragmented(**state, n);
+            }
+        };
+        c.run = [state, body] { body(**state); };
+        c.teardown = [state] { state->reset(); };
+        cases.push_back(c);
+    };
+
+    // Цикл как в PrintList
+    add("scan_iterator", [](const List& list) {
+        long long sum = 0;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            sum += *it;
+        }
+        g_sink = sum;
+    });
+    add("scan_prefetching_iterator", [](const List& list) {
+        long long sum = 0;
+        for (int value : list.WithPrefetch()) {
+            sum += value;
+        }
+        g_sink = sum;
+    });
+    add("accumulate", [](const List& list) { g_sink = list.Accumulate(0LL); });
+    add("count", [](const List& list) { g_sink = static_cast<long long>(list.Count(1)); });
+    add("find_missing", [](const List& list) { g_sink = (list.Find(1) == list.end()); });
+
+    add("work_iterator", [](const List& list) {
+        long long sum = 0;
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            sum += Work(*it);
+        }
+        g_sink = sum;
+    });
+    add("work_prefetching_iterator", [](const List& list) {
+        long long sum = 0;
+        for (int value : list.WithPrefetch()) {
+            sum += Work(value);
+        }
+        g_sink = sum;
+    });
+    add("work_for_each", [](const List& list) {
+        long long sum = 0;
+        list.ForEach([&sum](int value) { sum += Work(value); });
+        g_sink = sum;
+    });
+}
+
+void AddPrefetchSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        if (n >= 100000) {
+            AddPrefetchCases(cases, n);
+        }
+    }
+}
+
+
+// ---------- Набор parallel: параллельные алгоритмы на 1/2/4/8/16 потоках ----------
+
+// Список и пул создаются при первом prepare и удаляются в teardown. Контрольные точки строятся один раз
+// и переиспользуются между повторениями, кроме замера count_if_rebuild, где они строятся на каждом вызове
+void AddParallelCases(std::vector<BenchCase>& cases, size_t n, size_t threads) {
+    using List = SingleLinkedList<int>;
+    struct State {
+        State(size_t n, size_t threads) : list(MakeIntList<List>(n)), pool(threads) {}
+
+        List list;
+        WorkStealingPool pool;
+        ListCheckpoints<List> checkpoints;
+    };
+    auto state = std::make_shared<std::unique_ptr<State>>();
+    auto add = [&](const std::string& benchmark, std::function<void(State&)> body) {
+        BenchCase c;
+        c.benchmark = benchmark + "/threads=" + std::to_string(threads);
+        c.container = "SingleLinkedList";
+        c.type = "int";
+        c.size = n;
+        c.ops = n;
+        c.prepare = [state, n, threads] {
+            if (!*state) {
+                *state = std::make_unique<State>(n, threads);
+            }
+        };
+        c.run = [state, body] { body(**state); };
+        c.teardown = [state] { state->reset(); };
+        cases.push_back(c);
+    };
+
+    add("count_if", [](State& s) {
+        g_sink = static_cast<long long>(ParallelCountIf(s.list, s.checkpoints, [](int v) { return v % 3 == 0; }, s.pool));
+    });
+    add("count_if_rebuild", [](State& s) {
+        g_sink = static_cast<long long>(ParallelCountIf(s.list, [](int v) { return v % 3 == 0; }, s.pool));
+    });
+    add("transform_reduce_work", [](State& s) {
+        g_sink = ParallelTransformReduce(s.list, s.checkpoints, 0LL, std::plus<>{}, Work, s.pool);
+    });
+    add("for_each_work", [](State& s) {
+        std::atomic<long long> sum{0};
+        ParallelForEach(s.list, s.checkpoints, [&sum](int v) { sum.fetch_add(Work(v), std::memory_order_relaxed); }, s.pool);
+        g_sink = sum.load();
+    });
+}
+
+void AddParallelSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        if (n >= 1000000) {
+            for (size_t threads : {1, 2, 4, 8, 16}) {
+                AddParallelCases(cases, n, threads);
+            }
+        }
+    }
+}
+
+
+// ---------- Набор positional: доступ по позиции ----------
+
+// ops случайных обращений по позиции к списку из n элементов (список строится один раз, в первом prepare)
+template <typename List>
+void AddPositionalCase(std::vector<BenchCase>& cases, const std::string& benchmark, const std::string& container, size_t n,
+                       size_t ops, std::function<void(List&, size_t)> access) {
+    auto state = std::make_shared<std::optional<List>>();
+    auto positions = std::make_shared<std::vector<size_t>>();
+    BenchCase c;
+    c.benchmark = benchmark;
+    c.container = container;
+    c.type = "int";
+    c.size = n;
+    c.ops = ops;
+    c.prepare = [state, positions, n, ops] {
+        if (!*state) {
+            state->emplace(MakeIntList<List>(n));
+            std::mt19937 generator(42);
+            for (size_t i = 0; i < ops; ++i) {
+                positions->push_back(std::uniform_int_distribution<size_t>(0, n - 1)(generator));
+            }
+        }
+    };
+    c.run = [state, positions, access] {
+        for (size_t k : *positions) {
+            access(**state, k);
+        }
+    };
+    c.teardown = [state, positions] {
+        state->reset();
+        positions->clear();
+    };
+    cases.push_back(c);
+}
+
+void AddPositionalSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    using Plain = SingleLinkedList<int>;
+    using Positional = PositionalSingleLinkedList<int>;
+    for (size_t n : options.Sizes()) {
+        AddBuildCase<Plain>(cases, "SingleLinkedList", n);
+        AddBuildCase<Positional>(cases, "PositionalSingleLinkedList", n);
+        if (n < 100000) {
+            continue;
+        }
+        // Проход от begin() — O(k), поэтому обращений меньше
+        AddPositionalCase<Plain>(cases, "at_random", "SingleLinkedList", n, 100, [](Plain& list, size_t k) {
+            g_sink = *std::next(list.begin(), static_cast<std::ptrdiff_t>(k));
+        });
+        AddPositionalCase<Positional>(cases, "at_random", "PositionalSingleLinkedList", n, 10000, [](Positional& list, size_t k) {
+            g_sink = list.At(k);
+        });
+        AddPositionalCase<Positional>(cases, "insert_at_random", "PositionalSingleLinkedList", n, 10000,
+                                      [](Positional& list, size_t k) { list.InsertAfter(list.IteratorAt(k), 1); });
+        // Удаление и вставка в одной позиции: размер не меняется между повторениями
+        AddPositionalCase<Positional>(cases, "erase_insert_at_random", "PositionalSingleLinkedList", n, 10000,
+                                      [](Positional& list, size_t k) {
+                                          const auto pos = list.IteratorAt(k / 2);
+                                          list.InsertAfter(pos, *list.EraseAfter(pos));
+                                      });
+        AddPositionalCase<Positional>(cases, "position_of_random", "PositionalSingleLinkedList", n, 10000,
+                                      [](Positional& list, size_t k) { g_sink = static_cast<long long>(list.GetPosition(list.IteratorAt(k))); });
+    }
+}
+
+
+// ---------- Набор sorted: упорядоченные вставка и поиск ----------
+
+// Упорядоченный SingleLinkedList, как его вели вручную: место для вставки ищется линейным проходом
+struct LinearSortedList {
+    void Insert(int value) {
+        auto prev = list.before_begin();
+        for (auto it = list.begin(); it != list.end() && *it < value; ++it) {
+            prev = it;
+        }
+        list.InsertAfter(prev, value);
+    }
+
+    bool Contains(int value) const {
+        auto it = list.begin();
+        while (it != list.end() && *it < value) {
+            ++it;
+        }
+        return it != list.end() && *it == value;
+    }
+
+    SingleLinkedList<int> list;
+};
+
+template <typename Sorted>
+void SortedInsert(Sorted& sorted, int value) {
+    if constexpr (std::is_same_v<Sorted, std::multiset<int>>) {
+        sorted.insert(value);
+    } else {
+        sorted.Insert(value);
+    }
+}
+
+template <typename Sorted>
+bool SortedContains(const Sorted& sorted, int value) {
+    if constexpr (std::is_same_v<Sorted, std::multiset<int>>) {
+        return sorted.find(value) != sorted.end();
+    } else {
+        return sorted.Contains(value);
+    }
+}
+
+// Случайные значения из [0, 2n): примерно половина поисков находит элемент
+std::vector<int> MakeRandomValues(size_t count, size_t n, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> distribution(0, static_cast<int>(2 * n));
+    std::vector<int> values(count);
+    for (int& value : values) {
+        value = distribution(generator);
+    }
+    return values;
+}
+
+template <typename Sorted>
+Sorted MakeSorted(size_t n) {
+    std::vector<int> values = MakeRandomValues(n, n, 1);
+    if constexpr (std::is_same_v<Sorted, LinearSortedList>) {
+        std::sort(values.begin(), values.end());
+        Sorted sorted;
+        sorted.list.Assign(values.begin(), values.end());
+        return sorted;
+    } else {
+        Sorted sorted;
+        for (int value : values) {
+            SortedInsert(sorted, value);
+        }
+        return sorted;
+    }
+}
+
+// Построение из n случайных значений, затем ops вставок и ops поисков в готовом контейнере
+template <typename Sorted>
+void AddSortedCases(std::vector<BenchCase>& cases, const std::string& container, size_t n, size_t ops, bool build) {
+    if (build) {
+        auto built = std::make_shared<std::optional<Sorted>>();
+        auto values = std::make_shared<std::vector<int>>();
+        BenchCase c;
+        c.benchmark = "sorted_build_random";
+        c.container = container;
+        c.type = "int";
+        c.size = n;
+        c.ops = n;
+        c.prepare = [values, n] {
+            if (values->empty()) {
+                *values = MakeRandomValues(n, n, 1);
+            }
+        };
+        c.run = [built, values] {
+            built->emplace();
+            for (int value : *values) {
+                SortedInsert(**built, value);
+            }
+        };
+        c.cleanup = [built] { built->reset(); };
+        c.teardown = [values] { values->clear(); };
+        c.report_footprint = true;
+        cases.push_back(c);
+    }
+
+    auto state = std::make_shared<std::optional<Sorted>>();
+    auto probes = std::make_shared<std::vector<int>>();
+    auto add = [&](const std::string& benchmark, std::function<void(Sorted&, const std::vector<int>&)> body) {
+        BenchCase c;
+        c.benchmark = benchmark;
+        c.container = container;
+        c.type = "int";
+        c.size = n;
+        c.ops = ops;
+        c.prepare = [state, probes, n, ops] {
+            if (!*state) {
+                state->emplace(MakeSorted<Sorted>(n));
+                *probes = MakeRandomValues(ops, n, 2);
+            }
+        };
+        c.run = [state, probes, body] { body(**state, *probes); };
+        c.teardown = [state, probes] {
+            state->reset();
+            probes->clear();
+        };
+        cases.push_back(c);
+    };
+    add("sorted_find_random", [](Sorted& sorted, const std::vector<int>& values) {
+        long long found = 0;
+        for (int value : values) {
+            found += SortedContains(sorted, value);
+        }
+        g_sink = found;
+    });
+    // Контейнер растёт на ops элементов за повторение — на фоне n это незаметно
+    add("sorted_insert_random", [](Sorted& sorted, const std::vector<int>& values) {
+        for (int value : values) {
+            SortedInsert(sorted, value);
+        }
+    });
+}
+
+void AddSortedSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        if (n < 100000) {
+            continue;
+        }
+        AddSortedCases<SortedSingleLinkedList<int>>(cases, "SortedSingleLinkedList", n, 10000, true);
+        AddSortedCases<std::multiset<int>>(cases, "std::multiset", n, 10000, true);
+        // Линейный поиск места — O(n) на операцию, поэтому только на 1e5 и с меньшим числом операций
+        if (n == 100000) {
+            AddSortedCases<LinearSortedList>(cases, "SingleLinkedList+linear", n, 100, false);
+        }
+    }
+}
+
+
+// ---------- Набор hashed: поиск и удаление по ключу ----------
+
+using KeyedPair = std::pair<const int, int>;
+using KeyedList = SingleLinkedList<KeyedPair>;
+using HashedList = HashedSingleLinkedList<int, int>;
+
+// Предшественник элемента с ключом key в обычном списке — линейным проходом, как без индекса
+KeyedList::Iterator FindBeforeLinear(KeyedList& list, int key) {
+    auto before = list.before_begin();
+    for (auto it = list.begin(); it != list.end(); before = it++) {
+        if (it->first == key) {
+            return before;
+        }
+    }
+    return list.end();
+}
+
+// Ключи 0..n-1 в случайном порядке
+template <typename Keyed>
+Keyed MakeKeyed(size_t n) {
+    std::vector<int> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = static_cast<int>(i);
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(1));
+    Keyed keyed;
+    for (int key : keys) {
+        keyed.PushBack({key, key});
+    }
+    return keyed;
+}
+
+// Построение из n ключей, затем ops поисков (половина ключей отсутствует) и ops пар «удалить по ключу + вставить в конец»
+template <typename Keyed>
+void AddHashedCases(std::vector<BenchCase>& cases, const std::string& container, size_t n, size_t ops, bool build) {
+    if (build) {
+        auto built = std::make_shared<std::optional<Keyed>>();
+        BenchCase c;
+        c.benchmark = "keyed_build";
+        c.container = container;
+        c.type = "pair<int,int>";
+        c.size = n;
+        c.ops = n;
+        c.run = [built, n] { built->emplace(MakeKeyed<Keyed>(n)); };
+        c.cleanup = [built] { built->reset(); };
+        c.report_footprint = true;
+        cases.push_back(c);
+    }
+
+    auto state = std::make_shared<std::optional<Keyed>>();
+    auto probes = std::make_shared<std::vector<int>>();
+    auto add = [&](const std::string& benchmark, size_t key_range, std::function<void(Keyed&, const std::vector<int>&)> body) {
+        BenchCase c;
+        c.benchmark = benchmark;
+        c.container = container;
+        c.type = "pair<int,int>";
+        c.size = n;
+        c.ops = ops;
+        c.prepare = [state, probes, n, ops, key_range] {
+            if (!*state) {
+                state->emplace(MakeKeyed<Keyed>(n));
+                std::mt19937 generator(2);
+                std::uniform_int_distribution<int> distribution(0, static_cast<int>(key_range) - 1);
+                probes->resize(ops);
+                for (int& key : *probes) {
+                    key = distribution(generator);
+                }
+            }
+        };
+        c.run = [state, probes, body] { body(**state, *probes); };
+        c.teardown = [state, probes] {
+            state->reset();
+            probes->clear();
+        };
+        cases.push_back(c);
+    };
+    add("keyed_find_random", 2 * n, [](Keyed& keyed, const std::vector<int>& keys) {
+        long long found = 0;
+        for (int key : keys) {
+            if constexpr (std::is_same_v<Keyed, HashedList>) {
+                found += keyed.Find(key) != keyed.end();
+            } else {
+                found += FindBeforeLinear(keyed, key) != keyed.end();
+            }
+        }
+        g_sink = found;
+    });
+    // Размер не меняется между повторениями
+    add("keyed_erase_push_back_random", n, [](Keyed& keyed, const std::vector<int>& keys) {
+        for (int key : keys) {
+            if constexpr (std::is_same_v<Keyed, HashedList>) {
+                keyed.EraseByKey(key);
+            } else {
+                keyed.EraseAfter(FindBeforeLinear(keyed, key));
+            }
+            keyed.PushBack({key, key});
+        }
+    });
+}
+
+void AddHashedSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        if (n < 100000) {
+            continue;
+        }
+        AddHashedCases<HashedList>(cases, "HashedSingleLinkedList", n, 10000, true);
+        // Линейный поиск — O(n) на операцию, поэтому только на 1e5 и с меньшим числом операций
+        if (n == 100000) {
+            AddHashedCases<KeyedList>(cases, "SingleLinkedList+linear", n, 100, true);
+        }
+    }
+}
+
+
+// ---------- Набор lru: LRU-кеш под запросами с распределением Ципфа ----------
+
+// LRU-кеш в том виде, в каком его обычно пишут: std::list от свежих к старым и std::unordered_map ключ -> узел
+class StdLruCache {
+public:
+    explicit StdLruCache(size_t capacity) : capacity_(capacity) {
+        index_.reserve(capacity + 1);
+    }
+
+    long long* Get(int key) {
+        const auto found = index_.find(key);
+        if (found == index_.end()) {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, found->second);
+        return &found->second->second;
+    }
+
+    void Put(int key, long long value) {
+        if (long long* existing = Get(key)) {
+            *existing = value;
+            return;
+        }
+        entries_.emplace_front(key, value);
+        index_.emplace(key, entries_.begin());
+        if (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+private:
+    size_t capacity_;
+    std::list<std::pair<int, long long>> entries_;
+    std::unordered_map<int, std::list<std::pair<int, long long>>::iterator> index_;
+};
+
+// count ключей из [0, universe) с вероятностью ключа k, пропорциональной 1 / (k + 1)^skew.
+// Ключи перемешаны, чтобы частые не шли подряд в хеш-таблице
+std::vector<int> MakeZipfKeys(size_t count, size_t universe, double skew, unsigned seed) {
+    std::vector<double> cdf(universe);
+    double total = 0;
+    for (size_t k = 0; k < universe; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), skew);
+        cdf[k] = total;
+    }
+    std::vector<int> names(universe);
+    for (size_t k = 0; k < universe; ++k) {
+        names[k] = static_cast<int>(k);
+    }
+    std::mt19937 generator(seed);
+    std::shuffle(names.begin(), names.end(), generator);
+    std::uniform_real_distribution<double> distribution(0, total);
+    std::vector<int> keys(count);
+    for (int& key : keys) {
+        const size_t rank = static_cast<size_t>(std::lower_bound(cdf.begin(), cdf.end(), distribution(generator)) - cdf.begin());
+        key = names[std::min(rank, universe - 1)];
+    }
+    return keys;
+}
+
+// Чтение через кеш: Get, при промахе Put. Кеш на universe / 10 ключей.
+// Поток запросов в 8 раз длиннее одного повторения, и повторения идут по нему подряд, чтобы кеш не видел
+// одни и те же ops запросов снова и снова; первый prepare прогревает кеш целым проходом по потоку
+template <typename Cache>
+void AddLruCase(std::vector<BenchCase>& cases, const std::string& container, size_t universe, double skew, size_t ops) {
+    constexpr size_t kStreamRepeats = 8;
+    auto cache = std::make_shared<std::optional<Cache>>();
+    auto keys = std::make_shared<std::vector<int>>();
+    auto offset = std::make_shared<size_t>(0);
+    auto run = [cache, keys, offset, ops] {
+        const auto first = keys->begin() + static_cast<std::ptrdiff_t>(*offset);
+        for (auto it = first; it != first + static_cast<std::ptrdiff_t>(ops); ++it) {
+            if (!(*cache)->Get(*it)) {
+                (*cache)->Put(*it, *it);
+            }
+        }
+        *offset = (*offset + ops) % keys->size();
+    };
+    BenchCase c;
+    c.benchmark = "lru_zipf_" + std::to_string(skew).substr(0, 4);
+    c.container = container;
+    c.type = "int->long long";
+    c.size = universe;
+    c.ops = ops;
+    c.prepare = [cache, keys, universe, skew, ops, run] {
+        if (!*cache) {
+            cache->emplace(universe / 10);
+            *keys = MakeZipfKeys(ops * kStreamRepeats, universe, skew, 3);
+            for (size_t i = 0; i < kStreamRepeats; ++i) {
+                run();
+            }
+        }
+    };
+    c.run = run;
+    c.teardown = [cache, keys, offset] {
+        cache->reset();
+        keys->clear();
+        *offset = 0;
+    };
+    cases.push_back(c);
+}
+
+void AddLruSuite(std::vector<BenchCase>& cases, const BenchOptions& options) {
+    for (size_t n : options.Sizes()) {
+        // При n > 1e6 поток из 800 тысяч запросов не заполняет кеш, и вытеснение не замеряется
+        if (n < 100000 || n > 1000000) {
+            continue;
+        }
+        for (double skew : {0.8, 0.99}) {
+            AddLruCase<LruCache<int, long long>>(cases, "LruCache", n, skew, 100000);
+            AddLruCase<StdLruCache>(cases, "std::list+unordered_map", n, skew, 100000);
+        }
+    }
+}
+
+
+// ---------- Набор thread_cache: PushFront/PopFront с кешем узлов потока ----------
+
+// ops операций: пачками по batch PushFront, затем столько же PopFront.
+// Список живёт между повторениями, а первый prepare прогоняет одну пачку, поэтому замер идёт в установившемся режиме:
+// узлы для ThreadCachingAllocator и PoolAllocator уже выделены
+template <typename List>
+void AddChurnCase(std::vector<BenchCase>& cases, const std::string& container, size_t batch, size_t ops) {
+    auto list = std::make_shared<std::optional<List>>();
+    auto churn = [list, batch](size_t count) {
+        List& churned = **list;
+        long long sum = 0;
+        for (size_t done = 0; done < count; done += 2 * batch) {
+            for (size_t i = 0; i < batch; ++i) {
+                churned.PushFront(static_cast<int>(i));
+            }
+            for (size_t i = 0; i < batch; ++i) {
+                sum += churned.front();
+                churned.PopFront();
+            }
+        }
+        g_sink = sum;
+    };
+    BenchCase c;
+    c.benchmark = "push_pop_churn/batch=" + std::to_string(batch);
+    c.container = container;
+    c.type = "int";
+    c.size = batch;
+    c.ops = ops;
+    c.prepare = [list, churn, batch] {
+        if (!*list) {
+            list->emplace();
+            churn(2 * batch);
+        }
+    };
+    c.run = [churn, ops] { churn(ops); };
+    c.teardown = [list] {
+        list->reset();
+        ThreadNodeCache::Trim();
+    };
+    cases.push_back(c);
+}
+
+void AddThreadCacheSuite(std::vector<BenchCase>& cases, const BenchOptions&) {
+    for (size_t batch : {1, 64, 1024}) {
+        AddChurnCase<SingleLinkedList<int>>(cases, "SingleLinkedList", batch, 1 << 20);
+        AddChurnCase<SingleLinkedList<int, ThreadCachingAllocator<int>>>(cases, "SingleLinkedList+ThreadCachingAllocator", batch, 1 << 20);
+        AddChurnCase<SingleLinkedList<int, PoolAllocator<int>>>(cases, "SingleLinkedList+PoolAllocator", batch, 1 << 20);
+    }
+}
+
+
+// ---------- Набор stack: многопоточный стек ----------
+
+// Стек под общим мьютексом — то, чем пользовались до ConcurrentSingleLinkedList
+class LockedStack {
+public:
+    void PushFront(int value) {
+        std::lock_guard guard(mutex_);
+        list_.PushFront(value);
+    }
+
+    std::optional<int> PopFront() {
+        std::lock_guard guard(mutex_);
+        if (list_.IsEmpty()) {
+            return std::nullopt;
+        }
+        int value = *list_.begin();
+        list_.PopFront();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    SingleLinkedList<int> list_;
+};
+
+// Каждый поток делает ops_per_thread пар PushFront + PopFront. Время — на одну операцию по всем потокам
+template <typename Stack>
+void AddStackCase(std::vector<BenchCase>& cases, const std::string& container, int threads, size_t ops_per_thread) {
+    BenchCase c;
+    c.benchmark = "stack_push_pop/threads=" + std::to_string(threads);
+    c.container = container;
+    c.type = "int";
+    c.size = static_cast<size_t>(threads);
+    c.ops = 2 * ops_per_thread * static_cast<size_t>(threads);
+    c.run = [threads, ops_per_thread] {
+        Stack stack;
+        std::atomic<long long> total{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&stack, &total, ops_per_thread] {
+                long long sum = 0;
+                for (size_t i = 0; i < ops_per_thread; ++i) {
+                    stack.PushFront(static_cast<int>(i));
+                    sum += stack.PopFront().value_or(0);
+                }
+                total.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        g_sink = total.load();
+    };
+    cases.push_back(c);
+}
+
+void AddStackSuite(std::vector<BenchCase>& cases, const BenchOptions&) {
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        AddStackCase<LockedStack>(cases, "mutex+SingleLinkedList", threads, 100000);
+        AddStackCase<ConcurrentSingleLinkedList<int>>(cases, "ConcurrentSingleLinkedList", threads, 100000);
+    }
+}
+
+
+// ---------- Набор fine_grained: вставки и удаления в разных местах списка из нескольких потоков ----------
+
+// Список под общим мьютексом: место ищется линейным проходом, всё под одной блокировкой
+class GloballyLockedList {
+public:
+    void PushFront(int value) {
+        std::lock_guard guard(mutex_);
+        list_.PushFront(value);
+    }
+
+    void InsertAfterValue(int anchor, int value) {
+        std::lock_guard guard(mutex_);
+        list_.InsertAfter(list_.Find(anchor), value);
+    }
+
+    void EraseAfterValue(int anchor) {
+        std::lock_guard guard(mutex_);
+        list_.EraseAfter(list_.Find(anchor));
+    }
+
+    bool Contains(int value) {
+        std::lock_guard guard(mutex_);
+        return list_.Find(value) != list_.end();
+    }
+
+private:
+    std::mutex mutex_;
+    SingleLinkedList<int> list_;
+};
+
+// Тот же интерфейс поверх FineGrainedSingleLinkedList: якорь ищется курсором, Contains идёт без блокировок
+class FineGrainedAdapter {
+public:
+    void PushFront(int value) {
+        list_.PushFront(value);
+    }
+
+    void InsertAfterValue(int anchor, int value) {
+        list_.LockFirst(anchor).InsertAfter(value);
+    }
+
+    void EraseAfterValue(int anchor) {
+        list_.LockFirst(anchor).EraseAfter();
+    }
+
+    bool Contains(int value) const {
+        return list_.Contains(value);
+    }
+
+private:
+    FineGrainedSingleLinkedList<int> list_;
+};
+
+// Список из kFineGrainedLength значений 0..kFineGrainedLength-1 с якорями потоков -1, -2, ..., расставленными равномерно.
+// Каждый поток делает ops_per_thread операций: из каждых 10 contains_per_10 — Contains случайного значения,
+// остальные по очереди вставляют элемент после своего якоря и удаляют его. Время — на одну операцию по всем потокам
+inline constexpr int kFineGrainedLength = 256;
+
+template <typename List>
+void AddFineGrainedCase(std::vector<BenchCase>& cases, const std::string& benchmark, const std::string& container,
+                        int threads, int contains_per_10, size_t ops_per_thread) {
+    auto list = std::make_shared<std::optional<List>>();
+    BenchCase c;
+    c.benchmark = benchmark + "/threads=" + std::to_string(threads);
+    c.container = container;
+    c.type = "int";
+    c.size = kFineGrainedLength;
+    c.ops = ops_per_thread * static_cast<size_t>(threads);
+    c.prepare = [list, threads] {
+        list->emplace();
+        for (int i = kFineGrainedLength - 1; i >= 0; --i) {
+            (*list)->PushFront(i);
+            // Якорь потока t стоит перед значением t * длина / threads
+            for (int t = 0; t < threads; ++t) {
+                if (i == t * kFineGrainedLength / threads) {
+                    (*list)->PushFront(-(t + 1));
+                }
+            }
+        }
+    };
+    c.run = [list, threads, contains_per_10, ops_per_thread] {
+        std::atomic<long long> total{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&shared = **list, &total, t, contains_per_10, ops_per_thread] {
+                std::mt19937 generator(static_cast<unsigned>(t));
+                long long found = 0;
+                bool inserted = false;
+                for (size_t i = 0; i < ops_per_thread; ++i) {
+                    if (static_cast<int>(i % 10) < contains_per_10) {
+                        found += shared.Contains(static_cast<int>(generator() % kFineGrainedLength));
+                    } else if (!inserted) {
+                        shared.InsertAfterValue(-(t + 1), kFineGrainedLength + t);
+                        inserted = true;
+                    } else {
+                        shared.EraseAfterValue(-(t + 1));
+                        inserted = false;
+                    }
+                }
+                if (inserted) {
+                    shared.EraseAfterValue(-(t + 1));
+                }
+                total.fetch_add(found, std::memory_order_relaxed);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        g_sink = total.load();
+    };
+    c.cleanup = [list] { list->reset(); };
+    cases.push_back(c);
+}
+
+void AddFineGrainedSuite(std::vector<BenchCase>& cases, const BenchOptions&) {
+    for (int threads : {1, 2, 4, 8}) {
+        AddFineGrainedCase<GloballyLockedList>(cases, "insert_erase_at_anchor", "mutex+SingleLinkedList", threads, 0, 20000);
+        AddFineGrainedCase<FineGrainedAdapter>(cases, "insert_erase_at_anchor", "FineGrainedSingleLinkedList", threads, 0, 20000);
+        AddFineGrainedCase<GloballyLockedList>(cases, "contains_90_percent", "mutex+SingleLinkedList", threads, 9, 20000);
+        AddFineGrainedCase<FineGrainedAdapter>(cases, "contains_90_percent", "FineGrainedSingleLinkedList", threads, 9, 20000);
+    }
+}
+
+
+// ---------- Запуск ----------
+
+std::vector<BenchCase> CollectCases(const BenchOptions& options) {
+    using SuiteBuilder = void (*)(std::vector<BenchCase>&, const BenchOptions&);
+    const std::pair<const char*, SuiteBuilder> suites[] = {
+        {"containers", AddContainerSuite},
+        {"unrolled", AddUnrolledSuite},
+        {"sort", AddSortSuite},
+        {"compact", AddCompactSuite},
+        {"small", AddSmallSuite},
+        {"reload", AddReloadSuite},
+        {"persistent", AddPersistentSuite},
+        {"index", AddIndexSuite},
+        {"reclaim", AddReclaimSuite},
+        {"range", AddRangeSuite},
+        {"prefetch", AddPrefetchSuite},
+        {"parallel", AddParallelSuite},
+        {"positional", AddPositionalSuite},
+        {"sorted", AddSortedSuite},
+        {"hashed", AddHashedSuite},
+        {"lru", AddLruSuite},
+        {"thread_cache", AddThreadCacheSuite},
+        {"stack", AddStackSuite},
+        {"fine_grained", AddFineGrainedSuite},
+    };
+
+    std::vector<BenchCase> cases;
+    for (const auto& [name, build] : suites) {
+        if (options.HasSuite(name)) {
+            build(cases, options);
+        }
+    }
+    if (!options.filter.empty()) {
+        cases.erase(std::remove_if(cases.begin(), cases.end(),
+                                   [&options](const BenchCase& c) {
+                                       return c.benchmark.find(options.filter) == std::string::npos &&
+                                              c.container.find(options.filter) == std::string::npos;
+                                   }),
+                    cases.end());
+    }
+    return cases;
+}
+
+BenchOptions ParseOptions(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value_of = [&arg](const std::string& key) -> std::optional<std::string> {
+            if (arg.rfind(key, 0) == 0) {
+                return arg.substr(key.size());
+            }
+            return std::nullopt;
+        };
+        if (auto suites = value_of("--suite=")) {
+            size_t start = 0;
+            while (start <= suites->size()) {
+                const size_t comma = std::min(suites->find(',', start), suites->size());
+                options.suites.push_back(suites->substr(start, comma - start));
+                start = comma + 1;
+            }
+        } else if (auto max_size = value_of("--max-size=")) {
+            options.max_size = std::stoull(*max_size);
+        } else if (auto filter = value_of("--filter=")) {
+            options.filter = *filter;
+        } else if (auto format = value_of("--format=")) {
+            options.json = (*format == "json");
+        }
+    }
+    return options;
+}
+
+#ifdef SLL_USE_GOOGLE_BENCHMARK
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    const BenchOptions options = ParseOptions(argc, argv);
+    const std::vector<BenchCase> cases = CollectCases(options);
+    for (const BenchCase& bench_case : cases) {
+        const std::string name = bench_case.benchmark + "/" + bench_case.container + "/" + bench_case.type + "/" +
+                                 std::to_string(bench_case.size);
+        benchmark::RegisterBenchmark(name.c_str(), [bench_case](benchmark::State& state) {
+            size_t allocs = 0;
+            for (auto _ : state) {
+                state.PauseTiming();
+                bench_case.prepare();
+                const size_t allocs_before = g_allocations.count.load();
+                state.ResumeTiming();
+                bench_case.run();
+                state.PauseTiming();
+                allocs += g_allocations.count.load() - allocs_before;
+                bench_case.cleanup();
+                state.ResumeTiming();
+            }
+            const double ops = static_cast<double>(state.iterations() * bench_case.ops);
+            state.SetItemsProcessed(static_cast<int64_t>(ops));
+            state.counters["allocs_per_op"] = static_cast<double>(allocs) / ops;
+        })->UseRealTime();
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    for (const BenchCase& bench_case : cases) {
+        bench_case.teardown();
+    }
+    benchmark::Shutdown();
+}
+
+#else
+
+int main(int argc, char** argv) {
+    const BenchOptions options = ParseOptions(argc, argv);
+    Reporter reporter(options.json);
+    reporter.Begin();
+    for (const BenchCase& bench_case : CollectCases(options)) {
+        reporter.Report(bench_case, RunCase(bench_case));
+        bench_case.teardown();
+    }
+    reporter.End();
+}
+
+#endif
@@ -0,0 +1,225 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Hazard pointers: поток публикует указатель на узел, который сейчас читает,
+// и такой узел никто не удалит, пока публикация не снята.
+// У каждого потока kSlotsPerThread слотов: стеку хватает одного, а обходу списка без блокировок нужны два —
+// на текущий узел и на предыдущий, через который он проверяется.
+// Удаляемые узлы копятся в списке потока и проверяются пачкой, поэтому на одно удаление
+// приходится O(1) работы, а не проход по всем слотам
+class HazardPointers {
+public:
+    // Максимальное число потоков, одновременно работающих с lock-free списками
+    static constexpr size_t kMaxThreads = 128;
+    static constexpr size_t kSlotsPerThread = 2;
+
+    // Слот index текущего потока. Слоты потока захватываются при первом обращении и освобождаются при его завершении
+    static std::atomic<void*>& ForCurrentThread(size_t index = 0) {
+        thread_local SlotOwner owner;
+        return owner.GetPointer(index);
+    }
+
+    // Откладывает удаление p (через deleter) до момента, когда его не защищает ни один поток
+    static void Retire(void* p, void (*deleter)(void*)) {
+        thread_local RetiredList retired;
+        retired.items.push_back(Retired{p, deleter});
+        if (retired.items.size() >= kReclaimThreshold) {
+            Reclaim(retired.items);
+        }
+    }
+
+private:
+    static constexpr size_t kSlotCount = kMaxThreads * kSlotsPerThread;
+    // Сколько отложенных удалений копится в потоке, прежде чем их проверить
+    static constexpr size_t kReclaimThreshold = 2 * kSlotCount;
+
+    struct Slot {
+        std::atomic<bool> taken{false};
+        std::atomic<void*> pointer{nullptr};
+    };
+
+    struct Retired {
+        void* pointer;
+        void (*deleter)(void*);
+    };
+
+    class SlotOwner {
+    public:
+        // Поток занимает kSlotsPerThread подряд идущих слотов; занятость отмечается в первом из них
+        SlotOwner() {
+            for (size_t first = 0; first < kSlotCount; first += kSlotsPerThread) {
+                bool expected = false;
+                if (slots_[first].taken.compare_exchange_strong(expected, true)) {
+                    slots_begin_ = &slots_[first];
+                    return;
+                }
+            }
+            throw std::runtime_error("no free hazard pointer slots");
+        }
+
+        SlotOwner(const SlotOwner&) = delete;
+        SlotOwner& operator=(const SlotOwner&) = delete;
+
+        ~SlotOwner() {
+            for (size_t i = 0; i < kSlotsPerThread; ++i) {
+                slots_begin_[i].pointer.store(nullptr);
+            }
+            slots_begin_->taken.store(false);
+        }
+
+        std::atomic<void*>& GetPointer(size_t index) noexcept {
+            return slots_begin_[index].pointer;
+        }
+
+    private:
+        Slot* slots_begin_ = nullptr;
+    };
+
+    // Отложенные удаления потока. То, что не удалось удалить к завершению потока, достаётся сиротам
+    struct RetiredList {
+        ~RetiredList() {
+            Reclaim(items);
+            if (!items.empty()) {
+                std::lock_guard guard(orphans_.mutex);
+                orphans_.items.insert(orphans_.items.end(), items.begin(), items.end());
+            }
+        }
+
+        std::vector<Retired> items;
+    };
+
+    // Удаления, оставшиеся от завершившихся потоков. Разбираются при очередном Reclaim любого потока,
+    // а остаток — при завершении программы, когда защищать узлы уже некому
+    struct Orphans {
+        ~Orphans() {
+            for (const Retired& item : items) {
+                item.deleter(item.pointer);
+            }
+        }
+
+        std::mutex mutex;
+        std::vector<Retired> items;
+    };
+
+    // Удаляет из items всё, что сейчас никем не защищено
+    static void Reclaim(std::vector<Retired>& items) {
+        {
+            std::unique_lock guard(orphans_.mutex, std::try_to_lock);
+            if (guard.owns_lock() && !orphans_.items.empty()) {
+                items.insert(items.end(), orphans_.items.begin(), orphans_.items.end());
+                orphans_.items.clear();
+            }
+        }
+
+        void* hazards[kSlotCount];
+        size_t hazard_count = 0;
+        for (const Slot& slot : slots_) {
+            if (void* p = slot.pointer.load()) {
+                hazards[hazard_count++] = p;
+            }
+        }
+        std::sort(hazards, hazards + hazard_count);
+
+        auto still_protected = std::partition(items.begin(), items.end(), [&hazards, hazard_count](const Retired& item) {
+            return std::binary_search(hazards, hazards + hazard_count, item.pointer);
+        });
+        for (auto it = still_protected; it != items.end(); ++it) {
+            it->deleter(it->pointer);
+        }
+        items.erase(still_protected, items.end());
+    }
+
+    static Slot slots_[kSlotCount];
+    static Orphans orphans_;
+};
+
+inline HazardPointers::Slot HazardPointers::slots_[HazardPointers::kSlotCount];
+inline HazardPointers::Orphans HazardPointers::orphans_;
+
+
+// Lock-free стек (стек Трайбера) на односвязном списке для общего пула задач.
+// PushFront, PopFront и IsEmpty — CAS-операции над головой списка без блокировок.
+// Проблема ABA и безопасное освобождение узлов решаются hazard pointers: узел, который другой поток
+// мог начать читать, не удаляется (а значит, и не переиспользуется по тому же адресу), пока тот его защищает.
+// Снятые узлы удаляются отложенно, см. HazardPointers::Retire
+template <typename Type>
+class ConcurrentSingleLinkedList {
+    struct Node {
+        template <typename... Args>
+        explicit Node(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+        Type value;
+        // Записывается до публикации узла и больше не меняется
+        Node* next_node = nullptr;
+    };
+
+public:
+    using value_type = Type;
+
+    ConcurrentSingleLinkedList() = default;
+    ConcurrentSingleLinkedList(const ConcurrentSingleLinkedList&) = delete;
+    ConcurrentSingleLinkedList& operator=(const ConcurrentSingleLinkedList&) = delete;
+
+    // Вызывать, только когда другие потоки уже не работают со списком.
+    // Отложенные узлы не принадлежат списку и удалятся позже сами
+    ~ConcurrentSingleLinkedList() {
+        Node* node = head_.load();
+        while (node) {
+            delete std::exchange(node, node->next_node);
+        }
+    }
+
+    void PushFront(const Type& value) {
+        EmplaceFront(value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args>
+    void EmplaceFront(Args&&... args) {
+        Node* node = new Node(std::forward<Args>(args)...);
+        node->next_node = head_.load();
+        while (!head_.compare_exchange_weak(node->next_node, node)) {
+        }
+    }
+
+    // Снимает элемент с вершины. Если список пуст, возвращает std::nullopt
+    std::optional<Type> PopFront() {
+        std::atomic<void*>& hazard = HazardPointers::ForCurrentThread();
+        Node* old_head = head_.load();
+        do {
+            // Защищаем голову и перечитываем её: если она успела смениться, защищаем заново
+            Node* protected_head = nullptr;
+            do {
+                protected_head = old_head;
+                hazard.store(old_head);
+                old_head = head_.load();
+            } while (old_head != protected_head);
+        } while (old_head && !head_.compare_exchange_strong(old_head, old_head->next_node));
+        hazard.store(nullptr);
+
+        if (!old_head) {
+            return std::nullopt;
+        }
+        std::optional<Type> result(std::move(old_head->value));
+        HazardPointers::Retire(old_head, [](void* p) { delete static_cast<Node*>(p); });
+        return result;
+    }
+
+    // В многопоточной среде результат может устареть сразу после возврата
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return head_.load() == nullptr;
+    }
+
+private:
+    std::atomic<Node*> head_{nullptr};
+};
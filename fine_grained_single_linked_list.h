@@ -0,0 +1,310 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "concurrent_single_linked_list.h"
+
+// Спин-блокировка узла: один байт вместо сорока у std::mutex. Захват ждёт недолго (соседний поток лишь
+// переходит к следующему узлу), поэтому сначала крутится, а потом уступает процессор
+class NodeSpinLock {
+public:
+    void lock() noexcept {
+        while (locked_.exchange(true, std::memory_order_acquire)) {
+            for (int spins = 0; locked_.load(std::memory_order_relaxed); ++spins) {
+                if (spins >= kSpinsBeforeYield) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        locked_.store(false, std::memory_order_release);
+    }
+
+private:
+    static constexpr int kSpinsBeforeYield = 64;
+
+    std::atomic<bool> locked_{false};
+};
+
+// Односвязный список для нескольких пишущих потоков с блокировкой на каждом узле.
+// Изменения идут через Cursor — позицию, удерживающую блокировку своего узла. Курсор движется вперёд
+// «перехватом рук» (hand-over-hand): сначала блокируется следующий узел, потом отпускается текущий,
+// поэтому узел под курсором не может быть удалён, а курсоры проходят друг друга только по порядку и
+// взаимной блокировки не бывает. InsertAfter меняет лишь узел под курсором, EraseAfter — его и удаляемый,
+// так что вставки и удаления в непересекающихся местах списка идут параллельно.
+// Contains не берёт блокировок: он идёт по ссылкам, защищая текущий и предыдущий узлы hazard pointers,
+// а удаление сначала помечает узел (младший бит его ссылки next) и лишь потом вырезает его, поэтому читатель,
+// застав предыдущий узел помеченным или его ссылку изменённой, начинает обход заново.
+// Удалённые узлы освобождаются отложенно, см. HazardPointers::Retire.
+// Элементы после вставки не меняются: их без блокировок читает Contains
+template <typename Type>
+class FineGrainedSingleLinkedList {
+    struct Node;
+
+    struct NodeBase {
+        // Указатель на следующий Node; младший бит — пометка «этот узел удалён»
+        std::atomic<uintptr_t> next{0};
+        NodeSpinLock lock;
+    };
+
+    struct Node : NodeBase {
+        template <typename... Args>
+        explicit Node(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+        const Type value;
+    };
+
+    static constexpr uintptr_t kMarked = 1;
+
+    static Node* ToNode(uintptr_t link) noexcept {
+        return reinterpret_cast<Node*>(link & ~kMarked);
+    }
+
+    static uintptr_t ToLink(const Node* node) noexcept {
+        return reinterpret_cast<uintptr_t>(node);
+    }
+
+public:
+    using value_type = Type;
+
+    // Позиция в списке с удерживаемой блокировкой узла: before_begin или элемент.
+    // Пока курсор жив, его узел не удаляется, а другие курсоры не проходят дальше него.
+    // Курсор по умолчанию и перемещённый — пустые (ничего не держат)
+    class Cursor {
+        friend class FineGrainedSingleLinkedList;
+
+        Cursor(FineGrainedSingleLinkedList* list, NodeBase* node) noexcept : list_(list), node_(node) {}
+
+    public:
+        Cursor() = default;
+
+        Cursor(Cursor&& other) noexcept
+            : list_(std::exchange(other.list_, nullptr)), node_(std::exchange(other.node_, nullptr)) {}
+
+        Cursor& operator=(Cursor&& rhs) noexcept {
+            if (this != &rhs) {
+                Release();
+                list_ = std::exchange(rhs.list_, nullptr);
+                node_ = std::exchange(rhs.node_, nullptr);
+            }
+            return *this;
+        }
+
+        ~Cursor() {
+            Release();
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept {
+            return node_ != nullptr;
+        }
+
+        [[nodiscard]] bool IsBeforeBegin() const noexcept {
+            return node_ == &list_->head_;
+        }
+
+        // Элемент под курсором; для before_begin — неопределённое поведение
+        [[nodiscard]] const Type& operator*() const noexcept {
+            return static_cast<Node*>(node_)->value;
+        }
+
+        [[nodiscard]] const Type* operator->() const noexcept {
+            return &static_cast<Node*>(node_)->value;
+        }
+
+        [[nodiscard]] bool HasNext() const noexcept {
+            return ToNode(node_->next.load(std::memory_order_acquire)) != nullptr;
+        }
+
+        // Переходит к следующему элементу. Если его нет, возвращает false и остаётся на месте
+        bool Next() noexcept {
+            Node* next = ToNode(node_->next.load(std::memory_order_acquire));
+            if (!next) {
+                return false;
+            }
+            next->lock.lock();
+            node_->lock.unlock();
+            node_ = next;
+            return true;
+        }
+
+        // Вставляет элемент после курсора. Ссылка на него действительна, пока курсор не сдвинут:
+        // удалить вставленный узел может только тот, кто держит узел под курсором
+        template <typename... Args>
+        const Type& EmplaceAfter(Args&&... args) {
+            Node* node = new Node(std::forward<Args>(args)...);
+            node->next.store(node_->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            node_->next.store(ToLink(node), std::memory_order_release);
+            list_->size_.fetch_add(1, std::memory_order_relaxed);
+            return node->value;
+        }
+
+        const Type& InsertAfter(const Type& value) {
+            return EmplaceAfter(value);
+        }
+
+        const Type& InsertAfter(Type&& value) {
+            return EmplaceAfter(std::move(value));
+        }
+
+        // Удаляет элемент после курсора и возвращает копию его значения; std::nullopt, если курсор на последнем.
+        // Значение копируется, а не перемещается: его в это время может читать Contains
+        std::optional<Type> EraseAfter() {
+            Node* victim = ToNode(node_->next.load(std::memory_order_acquire));
+            if (!victim) {
+                return std::nullopt;
+            }
+            victim->lock.lock();
+            std::optional<Type> value(victim->value);
+            list_->Unlink(node_, victim);
+            return value;
+        }
+
+        // Отпускает блокировку; курсор становится пустым
+        void Release() noexcept {
+            if (node_) {
+                node_->lock.unlock();
+                node_ = nullptr;
+                list_ = nullptr;
+            }
+        }
+
+    private:
+        FineGrainedSingleLinkedList* list_ = nullptr;
+        NodeBase* node_ = nullptr;
+    };
+
+    FineGrainedSingleLinkedList() = default;
+    FineGrainedSingleLinkedList(const FineGrainedSingleLinkedList&) = delete;
+    FineGrainedSingleLinkedList& operator=(const FineGrainedSingleLinkedList&) = delete;
+
+    // Вызывать, только когда другие потоки уже не работают со списком и курсоров не осталось.
+    // Отложенные узлы не принадлежат списку и удалятся позже сами
+    ~FineGrainedSingleLinkedList() {
+        Node* node = ToNode(head_.next.load());
+        while (node) {
+            delete std::exchange(node, ToNode(node->next.load(std::memory_order_relaxed)));
+        }
+    }
+
+    // Курсор на позиции перед первым элементом. Ждёт, пока её не отпустят другие курсоры
+    [[nodiscard]] Cursor LockBeforeBegin() noexcept {
+        head_.lock.lock();
+        return Cursor(this, &head_);
+    }
+
+    // Курсор на первом элементе, удовлетворяющем pred, или пустой курсор, если такого нет
+    template <typename Predicate>
+    [[nodiscard]] Cursor LockFirstIf(Predicate pred) {
+        Cursor cursor = LockBeforeBegin();
+        while (cursor.Next()) {
+            if (pred(*cursor)) {
+                return cursor;
+            }
+        }
+        return Cursor();
+    }
+
+    [[nodiscard]] Cursor LockFirst(const Type& value) {
+        return LockFirstIf([&value](const Type& item) { return item == value; });
+    }
+
+    void PushFront(const Type& value) {
+        LockBeforeBegin().InsertAfter(value);
+    }
+
+    void PushFront(Type&& value) {
+        LockBeforeBegin().InsertAfter(std::move(value));
+    }
+
+    template <typename... Args>
+    void EmplaceFront(Args&&... args) {
+        LockBeforeBegin().EmplaceAfter(std::forward<Args>(args)...);
+    }
+
+    std::optional<Type> PopFront() {
+        return LockBeforeBegin().EraseAfter();
+    }
+
+    // Удаляет первый элемент, равный value. Возвращает false, если такого нет
+    bool Erase(const Type& value) {
+        NodeBase* prev = &head_;
+        prev->lock.lock();
+        while (Node* node = ToNode(prev->next.load(std::memory_order_acquire))) {
+            node->lock.lock();
+            if (node->value == value) {
+                Unlink(prev, node);
+                prev->lock.unlock();
+                return true;
+            }
+            prev->lock.unlock();
+            prev = node;
+        }
+        prev->lock.unlock();
+        return false;
+    }
+
+    // Есть ли в списке элемент, равный value. Без блокировок: не ждёт курсоры и не мешает им
+    [[nodiscard]] bool Contains(const Type& value) const {
+        std::atomic<void*>* hazards[2] = {&HazardPointers::ForCurrentThread(0), &HazardPointers::ForCurrentThread(1)};
+        std::optional<bool> found;
+        while (!found) {
+            found = TryContains(value, hazards);
+        }
+        hazards[0]->store(nullptr);
+        hazards[1]->store(nullptr);
+        return *found;
+    }
+
+    // В многопоточной среде результат может устареть сразу после возврата
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return ToNode(head_.next.load(std::memory_order_acquire)) == nullptr;
+    }
+
+private:
+    // Вырезает node, стоящий за prev; оба заблокированы. Блокировку node снимает, prev остаётся заблокированным
+    void Unlink(NodeBase* prev, Node* node) noexcept {
+        // Пометка раньше вырезания: читатель, стоящий на node, увидит её и не пойдёт по устаревшей ссылке
+        const uintptr_t next = node->next.fetch_or(kMarked);
+        prev->next.store(next);
+        // Ждать блокировку node мог только тот, кто держит prev, то есть мы сами, поэтому её можно снять до Retire
+        node->lock.unlock();
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        HazardPointers::Retire(node, [](void* p) { delete static_cast<Node*>(p); });
+    }
+
+    // Один проход для Contains. std::nullopt — проход сорван удалением, и его нужно начать заново.
+    // Узел защищается hazard pointer, а потом проверяется, что предыдущий узел ещё не помечен и всё так же
+    // ссылается на него: тогда в момент проверки узел был в списке, и Retire его не освободит
+    std::optional<bool> TryContains(const Type& value, std::atomic<void*>* hazards[2]) const {
+        const NodeBase* prev = &head_;
+        size_t slot = 0;
+        Node* node = ToNode(prev->next.load(std::memory_order_acquire));
+        while (node) {
+            hazards[slot]->store(node);
+            if (prev->next.load() != ToLink(node)) {
+                return std::nullopt;
+            }
+            const uintptr_t next = node->next.load(std::memory_order_acquire);
+            if (!(next & kMarked) && node->value == value) {
+                return true;
+            }
+            prev = node;
+            slot ^= 1;
+            node = ToNode(next);
+        }
+        return false;
+    }
+
+    NodeBase head_;
+    std::atomic<size_t> size_{0};
+};
@@ -0,0 +1,443 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "single_linked_list.h"
+
+// SingleLinkedList пар ключ-значение с хеш-индексом: Find(key), EraseByKey(key) и MoveToFront(key) за O(1) в среднем.
+// Индекс — таблица с открытой адресацией и линейным пробированием, отображающая ключ в итератор на узел перед элементом,
+// ведь именно он нужен EraseAfter. Каждая перевязка (InsertAfter, EraseAfter, MoveToFront, PopFront и т. д.)
+// меняет предшественника у двух-трёх элементов, и их записи в таблице правятся на месте.
+// Ключи уникальны. В записи хранится и перемешанный хеш ключа: при пробировании ключи сравниваются, только когда
+// совпали хеши, а при росте таблицы и удалении записей хеш-функция не вызывается вовсе.
+// Удаление сдвигает следующие записи назад, поэтому «надгробий» нет и поиск не деградирует от удалений.
+// Hash и KeyEqual не должны бросать исключений для ключей, уже лежащих в списке.
+// Итераторы инвалидируются так же, как у SingleLinkedList
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class HashedSingleLinkedList {
+public:
+    using value_type = std::pair<const Key, Value>;
+    using List = SingleLinkedList<value_type, Allocator>;
+    using Iterator = typename List::Iterator;
+    using ConstIterator = typename List::ConstIterator;
+
+    HashedSingleLinkedList() = default;
+
+    explicit HashedSingleLinkedList(const Allocator& alloc) : list_(alloc) {}
+
+    HashedSingleLinkedList(std::initializer_list<value_type> values, const Allocator& alloc = Allocator())
+        : list_(alloc) {
+        Reserve(values.size());
+        for (const value_type& value : values) {
+            PushBack(value);
+        }
+    }
+
+    HashedSingleLinkedList(const HashedSingleLinkedList& other)
+        : list_(other.list_), hash_(other.hash_), equal_(other.equal_) {
+        RebuildIndex();
+    }
+
+    // Забирает узлы и таблицу other вместе с его аллокатором; other остаётся пустым, с пустой таблицей
+    HashedSingleLinkedList(HashedSingleLinkedList&& other) noexcept
+        : list_(std::move(other.list_)),
+          slots_(std::move(other.slots_)),
+          shift_(std::exchange(other.shift_, 64)),
+          hash_(other.hash_),
+          equal_(other.equal_) {
+        other.slots_.clear();
+        FixFrontSlot(other.before_begin());
+    }
+
+    HashedSingleLinkedList& operator=(const HashedSingleLinkedList& rhs) {
+        if (this != &rhs) {
+            HashedSingleLinkedList copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    // Узлы забираются, если аллокатор переходит вместе с ними или аллокаторы равны. Иначе значения перемещаются
+    // в узлы своего аллокатора, а индекс строится заново
+    HashedSingleLinkedList& operator=(HashedSingleLinkedList&& rhs) noexcept(kMoveStealsNodes) {
+        if (this != &rhs) {
+            if (kMoveStealsNodes || list_.GetAllocator() == rhs.list_.GetAllocator()) {
+                HashedSingleLinkedList moved(std::move(rhs));
+                swap(moved);
+            } else {
+                HashedSingleLinkedList moved(List(std::move(rhs.list_), list_.GetAllocator()), rhs.hash_, rhs.equal_);
+                rhs.Clear();
+                swap(moved);
+            }
+        }
+        return *this;
+    }
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return list_.begin();
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return list_.begin();
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return list_.end();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return list_.end();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return list_.before_begin();
+    }
+
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return list_.before_begin();
+    }
+
+    [[nodiscard]] Iterator before_end() noexcept {
+        return list_.before_end();
+    }
+
+    [[nodiscard]] ConstIterator before_end() const noexcept {
+        return list_.before_end();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return list_.GetSize();
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return list_.IsEmpty();
+    }
+
+    [[nodiscard]] value_type& front() noexcept {
+        return list_.front();
+    }
+
+    [[nodiscard]] const value_type& front() const noexcept {
+        return list_.front();
+    }
+
+    [[nodiscard]] value_type& back() noexcept {
+        return list_.back();
+    }
+
+    [[nodiscard]] const value_type& back() const noexcept {
+        return list_.back();
+    }
+
+    // Сам список только для чтения: менять его в обход индекса нельзя
+    [[nodiscard]] const List& GetList() const noexcept {
+        return list_;
+    }
+
+    // Число мест в таблице индекса
+    [[nodiscard]] size_t GetBucketCount() const noexcept {
+        return slots_.size();
+    }
+
+    // Готовит таблицу к count элементам, чтобы вставки до этого размера не перестраивали её
+    void Reserve(size_t count) {
+        size_t capacity = kMinCapacity;
+        while (capacity / kMaxLoadDenominator * kMaxLoadNumerator < count) {
+            capacity *= 2;
+        }
+        if (capacity > slots_.size()) {
+            Rehash(capacity);
+        }
+    }
+
+    // Итератор на элемент с ключом key или end()
+    [[nodiscard]] Iterator Find(const Key& key) {
+        const size_t slot = FindSlot(key, Mix(key));
+        return slot == kNoSlot ? end() : std::next(slots_[slot].before);
+    }
+
+    [[nodiscard]] ConstIterator Find(const Key& key) const {
+        const size_t slot = FindSlot(key, Mix(key));
+        return slot == kNoSlot ? end() : std::next(slots_[slot].before);
+    }
+
+    // Итератор на элемент перед элементом с ключом key (before_begin() для первого) или end(), если ключа нет
+    [[nodiscard]] Iterator FindBefore(const Key& key) {
+        const size_t slot = FindSlot(key, Mix(key));
+        return slot == kNoSlot ? end() : slots_[slot].before;
+    }
+
+    [[nodiscard]] ConstIterator FindBefore(const Key& key) const {
+        const size_t slot = FindSlot(key, Mix(key));
+        return slot == kNoSlot ? end() : slots_[slot].before;
+    }
+
+    [[nodiscard]] bool Contains(const Key& key) const {
+        return FindSlot(key, Mix(key)) != kNoSlot;
+    }
+
+    // Вставляет элемент {key, Value(args...)} после pos, если ключа key ещё нет.
+    // Возвращает итератор на элемент с этим ключом и true, если вставка состоялась.
+    // При исключении список и индекс не меняются
+    template <typename K, typename... Args>
+    std::pair<Iterator, bool> TryEmplaceAfter(ConstIterator pos, K&& key, Args&&... args) {
+        const uint64_t hash = Mix(key);
+        if (const size_t slot = FindSlot(key, hash); slot != kNoSlot) {
+            return {std::next(slots_[slot].before), false};
+        }
+        Reserve(GetSize() + 1);
+        const ConstIterator next = std::next(pos);
+        // Запись следующего элемента ищется до вставки: после неё всё должно пройти без исключений
+        const size_t next_slot = next == end() ? kNoSlot : FindSlotOf(Mix(next->first), pos);
+        // Изменяемый итератор на pos: он уже записан у следующего элемента, а если следующего нет, pos — before_end()
+        const Iterator before = next_slot == kNoSlot ? before_end() : slots_[next_slot].before;
+        Iterator inserted = list_.EmplaceAfter(pos, std::piecewise_construct,
+                                               std::forward_as_tuple(std::forward<K>(key)),
+                                               std::forward_as_tuple(std::forward<Args>(args)...));
+        if (next_slot != kNoSlot) {
+            slots_[next_slot].before = inserted;
+        }
+        AddSlot(hash, before);
+        return {inserted, true};
+    }
+
+    std::pair<Iterator, bool> InsertAfter(ConstIterator pos, const value_type& value) {
+        return TryEmplaceAfter(pos, value.first, value.second);
+    }
+
+    std::pair<Iterator, bool> InsertAfter(ConstIterator pos, value_type&& value) {
+        return TryEmplaceAfter(pos, value.first, std::move(value.second));
+    }
+
+    std::pair<Iterator, bool> PushFront(const value_type& value) {
+        return InsertAfter(before_begin(), value);
+    }
+
+    std::pair<Iterator, bool> PushFront(value_type&& value) {
+        return InsertAfter(before_begin(), std::move(value));
+    }
+
+    std::pair<Iterator, bool> PushBack(const value_type& value) {
+        return InsertAfter(before_end(), value);
+    }
+
+    std::pair<Iterator, bool> PushBack(value_type&& value) {
+        return InsertAfter(before_end(), std::move(value));
+    }
+
+    // Удаляет элемент после pos. Возвращает итератор на элемент, следующий за удалённым
+    Iterator EraseAfter(ConstIterator pos) {
+        const ConstIterator erased = std::next(pos);
+        return EraseSlot(FindSlotOf(Mix(erased->first), pos));
+    }
+
+    // Удаляет элемент с ключом key. Возвращает true, если он был
+    bool EraseByKey(const Key& key) {
+        const size_t slot = FindSlot(key, Mix(key));
+        if (slot == kNoSlot) {
+            return false;
+        }
+        EraseSlot(slot);
+        return true;
+    }
+
+    void PopFront() {
+        EraseAfter(before_begin());
+    }
+
+    // Удаляет последний элемент; предшественник берётся из индекса, поэтому O(1)
+    void PopBack() {
+        EraseByKey(back().first);
+    }
+
+    // Перевешивает элемент с ключом key в начало списка без копирования и аллокаций.
+    // Возвращает false, если ключа нет
+    bool MoveToFront(const Key& key) {
+        const size_t slot = FindSlot(key, Mix(key));
+        if (slot == kNoSlot) {
+            return false;
+        }
+        const Iterator before = slots_[slot].before;
+        const Iterator head = before_begin();
+        if (before == head) {
+            return true;
+        }
+        const Iterator moved = std::next(before);
+        const ConstIterator next = std::next(moved);
+        const size_t front_slot = FindSlotOf(Mix(list_.front().first), head);
+        const size_t next_slot = next == end() ? kNoSlot : FindSlotOf(Mix(next->first), moved);
+        list_.SpliceAfter(head, list_, before, next);
+        slots_[slot].before = head;
+        slots_[front_slot].before = moved;
+        if (next_slot != kNoSlot) {
+            slots_[next_slot].before = before;
+        }
+        return true;
+    }
+
+    void Clear() noexcept {
+        list_.Clear();
+        std::fill(slots_.begin(), slots_.end(), Slot{});
+    }
+
+    // Обмен содержимым за O(1). Запись первого элемента указывает на before_begin() своего объекта,
+    // поэтому после обмена её нужно перевесить
+    void swap(HashedSingleLinkedList& other) noexcept {
+        const ConstIterator old_head = before_begin();
+        const ConstIterator other_old_head = other.before_begin();
+        list_.swap(other.list_);
+        slots_.swap(other.slots_);
+        std::swap(shift_, other.shift_);
+        std::swap(hash_, other.hash_);
+        std::swap(equal_, other.equal_);
+        FixFrontSlot(other_old_head);
+        other.FixFrontSlot(old_head);
+    }
+
+private:
+    // Запись таблицы. Свободна, если before == Iterator{} (конец списка не бывает предшественником)
+    struct Slot {
+        Iterator before;
+        uint64_t hash = 0;
+    };
+
+    static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+    static constexpr size_t kMinCapacity = 8;
+    static constexpr bool kMoveStealsNodes =
+        (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value &&
+         std::allocator_traits<Allocator>::propagate_on_container_swap::value) ||
+        std::allocator_traits<Allocator>::is_always_equal::value;
+
+    HashedSingleLinkedList(List&& list, const Hash& hash, const KeyEqual& equal)
+        : list_(std::move(list)), hash_(hash), equal_(equal) {
+        RebuildIndex();
+    }
+    // Таблица заполняется не более чем на 3/4
+    static constexpr size_t kMaxLoadNumerator = 3;
+    static constexpr size_t kMaxLoadDenominator = 4;
+
+    // Хеш умножается на 2^64 / φ, а место в таблице берётся из старших бит (фибоначчиево хеширование):
+    // std::hash целых чисел тождественен, и без перемешивания ключи с общим шагом собирались бы в кластеры
+    uint64_t Mix(const Key& key) const {
+        return static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    }
+
+    size_t HomeOf(uint64_t hash) const noexcept {
+        return static_cast<size_t>(hash >> shift_);
+    }
+
+    size_t NextSlot(size_t slot) const noexcept {
+        return (slot + 1) & (slots_.size() - 1);
+    }
+
+    static bool IsFree(const Slot& slot) noexcept {
+        return slot.before == Iterator{};
+    }
+
+    // Место записи ключа key или kNoSlot
+    size_t FindSlot(const Key& key, uint64_t hash) const {
+        if (IsEmpty()) {
+            return kNoSlot;
+        }
+        for (size_t slot = HomeOf(hash); !IsFree(slots_[slot]); slot = NextSlot(slot)) {
+            if (slots_[slot].hash == hash && equal_(std::next(slots_[slot].before)->first, key)) {
+                return slot;
+            }
+        }
+        return kNoSlot;
+    }
+
+    // Место записи элемента, стоящего после before. Сравниваются только итераторы, ключи не трогаются
+    size_t FindSlotOf(uint64_t hash, ConstIterator before) const noexcept {
+        size_t slot = HomeOf(hash);
+        while (slots_[slot].before != before) {
+            slot = NextSlot(slot);
+        }
+        return slot;
+    }
+
+    void AddSlot(uint64_t hash, Iterator before) noexcept {
+        size_t slot = HomeOf(hash);
+        while (!IsFree(slots_[slot])) {
+            slot = NextSlot(slot);
+        }
+        slots_[slot] = Slot{before, hash};
+    }
+
+    // Освобождает место и сдвигает назад следующие записи, которые могут его занять,
+    // чтобы цепочки пробирования не рвались
+    void RemoveSlot(size_t hole) noexcept {
+        for (size_t slot = NextSlot(hole); !IsFree(slots_[slot]); slot = NextSlot(slot)) {
+            const size_t mask = slots_.size() - 1;
+            const size_t home = HomeOf(slots_[slot].hash);
+            // Запись можно перенести в дыру, если дыра лежит между её домашним местом и текущим
+            if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+                slots_[hole] = slots_[slot];
+                hole = slot;
+            }
+        }
+        slots_[hole] = Slot{};
+    }
+
+    Iterator EraseSlot(size_t slot) {
+        const Iterator before = slots_[slot].before;
+        const ConstIterator erased = std::next(before);
+        const ConstIterator next = std::next(erased);
+        const uint64_t next_hash = next == end() ? 0 : Mix(next->first);
+        RemoveSlot(slot);
+        if (next != end()) {
+            slots_[FindSlotOf(next_hash, erased)].before = before;
+        }
+        return list_.EraseAfter(before);
+    }
+
+    void Rehash(size_t capacity) {
+        std::vector<Slot> old(capacity);
+        old.swap(slots_);
+        shift_ = 64;
+        for (size_t bits = capacity; bits > 1; bits /= 2) {
+            --shift_;
+        }
+        for (const Slot& slot : old) {
+            if (!IsFree(slot)) {
+                AddSlot(slot.hash, slot.before);
+            }
+        }
+    }
+
+    void RebuildIndex() {
+        Reserve(GetSize());
+        for (auto before = list_.before_begin(), it = list_.begin(); it != list_.end(); before = it++) {
+            AddSlot(Mix(it->first), before);
+        }
+    }
+
+    void FixFrontSlot(ConstIterator old_head) noexcept {
+        if (!IsEmpty()) {
+            slots_[FindSlotOf(Mix(list_.front().first), old_head)].before = before_begin();
+        }
+    }
+
+    List list_;
+    std::vector<Slot> slots_;
+    // 64 - log2(slots_.size())
+    unsigned shift_ = 64;
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] KeyEqual equal_;
+};
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+void swap(HashedSingleLinkedList<Key, Value, Hash, KeyEqual, Allocator>& lhs,
+          HashedSingleLinkedList<Key, Value, Hash, KeyEqual, Allocator>& rhs) noexcept {
+    lhs.swap(rhs);
+}
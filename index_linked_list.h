@@ -0,0 +1,394 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Односвязный список, узлы которого лежат в одном std::vector, а ссылки — индексы типа Index (по умолчанию 32 бита).
+// Узел SingleLinkedList<int> на 64-битной платформе — 16 байт плюс служебные данные аллокатора на каждый узел;
+// здесь узел int — 8 байт, аллокаций по одной на узел нет, а соседние узлы делят страницы памяти.
+// Места удалённых узлов запоминаются в списке свободных индексов и занимаются следующими вставками.
+// Интерфейс повторяет SingleLinkedList (before_begin, InsertAfter, EraseAfter, PopFront).
+//
+// Итератор хранит список и индекс, поэтому рост хранилища его не инвалидирует: итераторы и индексы
+// остаются валидными до удаления их элемента, а ссылки и указатели на элементы — только до ближайшей вставки.
+// Перемещение и обмен списков инвалидируют итераторы (они указывают на объект списка)
+template <typename Type, typename Index = uint32_t>
+class IndexLinkedList {
+    static_assert(std::is_unsigned_v<Index>, "index must be an unsigned integer");
+
+    // «Нет узла» (конец списка) и позиция перед первым элементом
+    static constexpr Index kNull = std::numeric_limits<Index>::max();
+    static constexpr Index kBeforeBegin = kNull - 1;
+
+    // Слот хранилища. Значение сконструировано, только пока слот занят
+    struct Slot {
+        Type& Value() noexcept {
+            return *std::launder(reinterpret_cast<Type*>(storage));
+        }
+
+        const Type& Value() const noexcept {
+            return *std::launder(reinterpret_cast<const Type*>(storage));
+        }
+
+        Index next_node;
+        alignas(Type) unsigned char storage[sizeof(Type)];
+    };
+
+    template <typename ValueType>
+    class BasicIterator {
+        friend class IndexLinkedList;
+
+        BasicIterator(const IndexLinkedList* list, Index index) : list_(list), index_(index) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        // При ValueType, совпадающем с const Type, играет роль конвертирующего конструктора
+        BasicIterator(const BasicIterator<Type>& other) noexcept : list_(other.list_), index_(other.index_) {}
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        template <typename OtherValueType>
+        [[nodiscard]] bool operator==(const BasicIterator<OtherValueType>& rhs) const noexcept {
+            return index_ == rhs.index_;
+        }
+
+        template <typename OtherValueType>
+        [[nodiscard]] bool operator!=(const BasicIterator<OtherValueType>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        BasicIterator& operator++() noexcept {
+            index_ = list_->NextOf(index_);
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return const_cast<Slot&>(list_->slots_[index_]).Value();
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &**this;
+        }
+
+    private:
+        const IndexLinkedList* list_ = nullptr;
+        Index index_ = kNull;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    // Наибольшее число узлов: два значения Index зарезервированы под end() и before_begin()
+    static constexpr size_t kMaxSize = static_cast<size_t>(kBeforeBegin);
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator(this, head_);
+    }
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return Iterator(this, head_);
+    }
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator(this, kNull);
+    }
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return Iterator(this, kNull);
+    }
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator(this, kBeforeBegin);
+    }
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return Iterator(this, kBeforeBegin);
+    }
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+public:
+    IndexLinkedList() = default;
+
+    IndexLinkedList(std::initializer_list<Type> values) {
+        FillWithValues(values.begin(), values.end());
+    }
+
+    // Копия хранит узлы подряд в порядке обхода
+    IndexLinkedList(const IndexLinkedList& other) {
+        FillWithValues(other.begin(), other.end());
+    }
+
+    IndexLinkedList(IndexLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    IndexLinkedList& operator=(const IndexLinkedList& rhs) {
+        if (this != &rhs) {
+            IndexLinkedList temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    IndexLinkedList& operator=(IndexLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~IndexLinkedList() {
+        DestroyValues();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Число узлов, которые поместятся без перевыделения хранилища
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return slots_.capacity();
+    }
+
+    // Выделяет хранилище под count узлов заранее
+    void Reserve(size_t count) {
+        if (count > slots_.capacity()) {
+            Grow(count);
+        }
+    }
+
+    [[nodiscard]] reference front() noexcept {
+        assert(!IsEmpty());
+        return slots_[head_].Value();
+    }
+
+    [[nodiscard]] const_reference front() const noexcept {
+        assert(!IsEmpty());
+        return slots_[head_].Value();
+    }
+
+    void PushFront(const Type& value) {
+        EmplaceFront(value);
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        return *EmplaceAfter(before_begin(), std::forward<Args>(args)...);
+    }
+
+    // Возвращает итератор на вставленный элемент.
+    // Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        return EmplaceAfter(pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        // Значение строится до возможного роста хранилища: args могут ссылаться на элементы этого списка
+        Type value(std::forward<Args>(args)...);
+        const Index index = AcquireSlot();
+        ::new (static_cast<void*>(slots_[index].storage)) Type(std::move(value));
+        Index& link = LinkOf(pos.index_);
+        slots_[index].next_node = link;
+        link = index;
+        ++size_;
+        return Iterator(this, index);
+    }
+
+    void PopFront() noexcept {
+        EraseAfter(before_begin());
+    }
+
+    // Возвращает итератор на элемент, следующий за удалённым. Место удалённого узла займёт следующая вставка
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        Index& link = LinkOf(pos.index_);
+        const Index index = link;
+        if (index != kNull) {
+            Slot& slot = slots_[index];
+            link = slot.next_node;
+            slot.Value().~Type();
+            slot.next_node = free_;
+            free_ = index;
+            --size_;
+        }
+        return Iterator(this, link);
+    }
+
+    // Удаляет все элементы. Хранилище остаётся выделенным для следующих вставок
+    void Clear() noexcept {
+        DestroyValues();
+        slots_.clear();
+        head_ = kNull;
+        free_ = kNull;
+        size_ = 0;
+    }
+
+    void swap(IndexLinkedList& other) noexcept {
+        slots_.swap(other.slots_);
+        std::swap(head_, other.head_);
+        std::swap(free_, other.free_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    Index NextOf(Index index) const noexcept {
+        return index == kBeforeBegin ? head_ : slots_[index].next_node;
+    }
+
+    Index& LinkOf(Index index) noexcept {
+        return index == kBeforeBegin ? head_ : slots_[index].next_node;
+    }
+
+    // Индекс свободного слота: из списка свободных либо новый в конце хранилища
+    Index AcquireSlot() {
+        if (free_ != kNull) {
+            return std::exchange(free_, slots_[free_].next_node);
+        }
+        if (slots_.size() == kMaxSize) {
+            throw std::length_error("IndexLinkedList is full");
+        }
+        if (slots_.size() == slots_.capacity()) {
+            Grow(std::min(kMaxSize, std::max<size_t>(16, slots_.capacity() * 2)));
+        }
+        slots_.push_back(Slot{});
+        return static_cast<Index>(slots_.size() - 1);
+    }
+
+    // Увеличивает ёмкость хранилища до capacity. Индексы узлов не меняются.
+    // Тривиально копируемые значения переезжают вместе со слотами, остальные перемещаются по одному;
+    // если перемещение бросит исключение, список останется прежним
+    void Grow(size_t capacity) {
+        if constexpr (std::is_trivially_copyable_v<Type>) {
+            slots_.reserve(capacity);
+        } else {
+            std::vector<Slot> grown;
+            grown.reserve(capacity);
+            grown.resize(slots_.size());
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                grown[i].next_node = slots_[i].next_node;
+            }
+            Index moved_until = head_;
+            try {
+                for (; moved_until != kNull; moved_until = slots_[moved_until].next_node) {
+                    ::new (static_cast<void*>(grown[moved_until].storage)) Type(std::move_if_noexcept(slots_[moved_until].Value()));
+                }
+            } catch (...) {
+                for (Index i = head_; i != moved_until; i = slots_[i].next_node) {
+                    grown[i].Value().~Type();
+                }
+                throw;
+            }
+            DestroyValues();
+            slots_.swap(grown);
+        }
+    }
+
+    void DestroyValues() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<Type>) {
+            for (Index i = head_; i != kNull; i = slots_[i].next_node) {
+                slots_[i].Value().~Type();
+            }
+        }
+    }
+
+    // Вызывается только из конструкторов, когда список ещё пуст
+    template <typename SourceIterator>
+    void FillWithValues(SourceIterator begin_, SourceIterator end_) {
+        try {
+            ConstIterator last = before_begin();
+            for (auto it = begin_; it != end_; ++it) {
+                last = EmplaceAfter(last, *it);
+            }
+        } catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    Index head_ = kNull;
+    // Первый свободный слот; свободные слоты связаны через next_node
+    Index free_ = kNull;
+    size_t size_ = 0;
+};
+
+
+template <typename Type, typename Index>
+void swap(IndexLinkedList<Type, Index>& lhs, IndexLinkedList<Type, Index>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, typename Index>
+bool operator==(const IndexLinkedList<Type, Index>& lhs, const IndexLinkedList<Type, Index>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Index>
+bool operator!=(const IndexLinkedList<Type, Index>& lhs, const IndexLinkedList<Type, Index>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Index>
+bool operator<(const IndexLinkedList<Type, Index>& lhs, const IndexLinkedList<Type, Index>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, typename Index>
+bool operator<=(const IndexLinkedList<Type, Index>& lhs, const IndexLinkedList<Type, Index>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Index>
+bool operator>(const IndexLinkedList<Type, Index>& lhs, const IndexLinkedList<Type, Index>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Index>
+bool operator>=(const IndexLinkedList<Type, Index>& lhs, const IndexLinkedList<Type, Index>& rhs) {
+    return !(lhs < rhs);
+}
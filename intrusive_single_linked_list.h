@@ -0,0 +1,312 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Что делать с объектом, когда список перестаёт на него ссылаться (EraseAfter, PopFront, Clear, деструктор)
+
+// Ничего: объектами владеет кто-то другой (пул, массив, другой список)
+struct IntrusiveNonOwning {
+    template <typename T>
+    void operator()(T*) const noexcept {}
+};
+
+// Удалить через delete: список владеет объектами, созданными через new
+struct IntrusiveDeleteDisposer {
+    template <typename T>
+    void operator()(T* object) const noexcept {
+        delete object;
+    }
+};
+
+
+class IntrusiveListHook;
+
+template <typename T, IntrusiveListHook T::*Hook, typename Disposer = IntrusiveNonOwning>
+class IntrusiveSingleLinkedList;
+
+// Член-крючок, через который объект связывается в IntrusiveSingleLinkedList.
+// Объект может одновременно состоять в нескольких списках — по крючку на каждый.
+// Крючок помнит свой объект, поэтому годится для любого T, в том числе с виртуальными базами.
+// Копирование объекта не копирует связи: крючок копии свободен, а присваивание крючок не трогает
+class IntrusiveListHook {
+    template <typename T, IntrusiveListHook T::*, typename>
+    friend class IntrusiveSingleLinkedList;
+
+public:
+    IntrusiveListHook() = default;
+
+    IntrusiveListHook(const IntrusiveListHook&) noexcept {}
+
+    IntrusiveListHook& operator=(const IntrusiveListHook&) noexcept {
+        return *this;
+    }
+
+private:
+    IntrusiveListHook* next_hook_ = nullptr;
+    // Объект, которому принадлежит крючок; записывается при вставке в список
+    void* owner_ = nullptr;
+};
+
+
+// Интрузивный односвязный список: элементы — сами объекты пользователя, связанные через крючок Hook.
+// Список ничего не выделяет и не копирует, а лишь перевешивает указатели в крючках.
+// Интерфейс повторяет SingleLinkedList: before_begin, InsertAfter, EraseAfter, PopFront, PushBack за O(1).
+// Объект, вставленный в список, должен жить и оставаться на месте, пока он в списке;
+// один и тот же крючок нельзя использовать для двух списков одновременно.
+// Disposer вызывается для каждого объекта, который список убирает (см. IntrusiveNonOwning, IntrusiveDeleteDisposer)
+template <typename T, IntrusiveListHook T::*Hook, typename Disposer>
+class IntrusiveSingleLinkedList {
+    // ValueType — совпадает с T (для Iterator) либо с const T (для ConstIterator)
+    template <typename ValueType>
+    class BasicIterator {
+        friend class IntrusiveSingleLinkedList;
+
+        explicit BasicIterator(IntrusiveListHook* hook) : hook_(hook) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        // При ValueType, совпадающем с const T, играет роль конвертирующего конструктора
+        BasicIterator(const BasicIterator<T>& other) noexcept : hook_(other.hook_) {}
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        [[nodiscard]] bool operator==(const BasicIterator<const T>& rhs) const noexcept {
+            return hook_ == rhs.hook_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<const T>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        [[nodiscard]] bool operator==(const BasicIterator<T>& rhs) const noexcept {
+            return hook_ == rhs.hook_;
+        }
+
+        [[nodiscard]] bool operator!=(const BasicIterator<T>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        BasicIterator& operator++() noexcept {
+            hook_ = hook_->next_hook_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return *OwnerOf(hook_);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return OwnerOf(hook_);
+        }
+
+    private:
+        IntrusiveListHook* hook_ = nullptr;
+    };
+
+public:
+    using value_type = T;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using Iterator = BasicIterator<T>;
+    using ConstIterator = BasicIterator<const T>;
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator(head_.next_hook_);
+    }
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return Iterator(head_.next_hook_);
+    }
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator(nullptr);
+    }
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return Iterator(nullptr);
+    }
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator(&head_);
+    }
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return Iterator(const_cast<IntrusiveListHook*>(&head_));
+    }
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+    // Последний элемент (для пустого списка совпадает с before_begin())
+    [[nodiscard]] Iterator before_end() noexcept {
+        return Iterator(tail_);
+    }
+    [[nodiscard]] ConstIterator cbefore_end() const noexcept {
+        return Iterator(tail_);
+    }
+    [[nodiscard]] ConstIterator before_end() const noexcept {
+        return cbefore_end();
+    }
+
+    // Итератор на объект, который уже лежит в этом списке, за O(1) — без поиска
+    [[nodiscard]] Iterator IteratorTo(T& object) noexcept {
+        return Iterator(&(object.*Hook));
+    }
+    [[nodiscard]] ConstIterator IteratorTo(const T& object) const noexcept {
+        return Iterator(const_cast<IntrusiveListHook*>(&(object.*Hook)));
+    }
+
+public:
+    IntrusiveSingleLinkedList() = default;
+
+    explicit IntrusiveSingleLinkedList(Disposer disposer) : disposer_(std::move(disposer)) {}
+
+    // Объекты нельзя разделить между двумя списками с одним крючком, поэтому копирования нет
+    IntrusiveSingleLinkedList(const IntrusiveSingleLinkedList&) = delete;
+    IntrusiveSingleLinkedList& operator=(const IntrusiveSingleLinkedList&) = delete;
+
+    // Забирает объекты other за O(1), other остаётся пустым
+    IntrusiveSingleLinkedList(IntrusiveSingleLinkedList&& other) noexcept : disposer_(other.disposer_) {
+        swap(other);
+    }
+
+    IntrusiveSingleLinkedList& operator=(IntrusiveSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~IntrusiveSingleLinkedList() {
+        Clear();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] reference front() noexcept {
+        assert(!IsEmpty());
+        return *begin();
+    }
+    [[nodiscard]] const_reference front() const noexcept {
+        assert(!IsEmpty());
+        return *begin();
+    }
+
+    [[nodiscard]] reference back() noexcept {
+        assert(!IsEmpty());
+        return *before_end();
+    }
+    [[nodiscard]] const_reference back() const noexcept {
+        assert(!IsEmpty());
+        return *before_end();
+    }
+
+    void PushFront(T& object) noexcept {
+        InsertAfter(before_begin(), object);
+    }
+
+    void PushBack(T& object) noexcept {
+        InsertAfter(before_end(), object);
+    }
+
+    // Связывает object после pos. Возвращает итератор на него
+    Iterator InsertAfter(ConstIterator pos, T& object) noexcept {
+        IntrusiveListHook* hook = &(object.*Hook);
+        hook->owner_ = &object;
+        hook->next_hook_ = pos.hook_->next_hook_;
+        pos.hook_->next_hook_ = hook;
+        if (pos.hook_ == tail_) {
+            tail_ = hook;
+        }
+        ++size_;
+        return Iterator(hook);
+    }
+
+    void PopFront() noexcept {
+        EraseAfter(before_begin());
+    }
+
+    // Отвязывает элемент после pos и передаёт его Disposer. Возвращает итератор на элемент, следующий за удалённым
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        IntrusiveListHook* hook = pos.hook_->next_hook_;
+        if (hook) {
+            pos.hook_->next_hook_ = std::exchange(hook->next_hook_, nullptr);
+            if (hook == tail_) {
+                tail_ = pos.hook_;
+            }
+            --size_;
+            disposer_(OwnerOf(hook));
+        }
+        return Iterator(pos.hook_->next_hook_);
+    }
+
+    // Отвязывает все элементы, передавая каждый Disposer
+    void Clear() noexcept {
+        while (head_.next_hook_) {
+            IntrusiveListHook* hook = head_.next_hook_;
+            head_.next_hook_ = std::exchange(hook->next_hook_, nullptr);
+            disposer_(OwnerOf(hook));
+        }
+        tail_ = &head_;
+        size_ = 0;
+    }
+
+    // Обменивает содержимое списков за O(1)
+    void swap(IntrusiveSingleLinkedList& other) noexcept {
+        std::swap(head_.next_hook_, other.head_.next_hook_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+        // У пустого списка хвост — его собственный фиктивный крючок, он не переезжает
+        FixEmptyTail();
+        other.FixEmptyTail();
+    }
+
+private:
+    // Объект, которому принадлежит крючок элемента списка
+    static T* OwnerOf(IntrusiveListHook* hook) noexcept {
+        return static_cast<T*>(hook->owner_);
+    }
+
+    void FixEmptyTail() noexcept {
+        if (!head_.next_hook_) {
+            tail_ = &head_;
+        }
+    }
+
+    IntrusiveListHook head_;
+    IntrusiveListHook* tail_ = &head_;
+    size_t size_ = 0;
+    [[no_unique_address]] Disposer disposer_;
+};
+
+
+template <typename T, IntrusiveListHook T::*Hook, typename Disposer>
+void swap(IntrusiveSingleLinkedList<T, Hook, Disposer>& lhs, IntrusiveSingleLinkedList<T, Hook, Disposer>& rhs) noexcept {
+    lhs.swap(rhs);
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Фоновый поток, уничтожающий цепочки узлов, которые списки отдали ему в SingleLinkedList::ClearDeferred.
+// Список лишь передаёт начало цепочки, поэтому вызывающий поток возвращается за O(1),
+// а деструкторы элементов и освобождение памяти выполняются здесь, в порядке поступления цепочек.
+// Деструкторы элементов должны допускать вызов из другого потока.
+// Потокобезопасен. Деструктор дожидается уничтожения всех переданных цепочек
+class ListReclaimer {
+public:
+    ListReclaimer() : worker_([this] { Run(); }) {}
+
+    ListReclaimer(const ListReclaimer&) = delete;
+    ListReclaimer& operator=(const ListReclaimer&) = delete;
+
+    ~ListReclaimer() {
+        {
+            std::lock_guard guard(mutex_);
+            stopping_ = true;
+        }
+        has_work_.notify_one();
+        worker_.join();
+    }
+
+    // Общий для всей программы экземпляр. Поток запускается при первом обращении
+    static ListReclaimer& Default() {
+        static ListReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    // Ставит в очередь уничтожение цепочки: reclaim(chain, context) будет вызвана в фоновом потоке.
+    // Может бросить std::bad_alloc; тогда задача не поставлена
+    void Submit(void (*reclaim)(void*, void*), void* chain, void* context) {
+        {
+            std::lock_guard guard(mutex_);
+            tasks_.push_back(Task{reclaim, chain, context});
+        }
+        has_work_.notify_one();
+    }
+
+    // Ждёт, пока будут уничтожены все цепочки, переданные до вызова
+    void Drain() {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+    }
+
+    // Сколько цепочек ждут уничтожения (включая обрабатываемую)
+    [[nodiscard]] size_t GetPending() const {
+        std::lock_guard guard(mutex_);
+        return tasks_.size() + (busy_ ? 1 : 0);
+    }
+
+private:
+    struct Task {
+        void (*reclaim)(void*, void*);
+        void* chain;
+        void* context;
+    };
+
+    void Run() {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            has_work_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            const Task task = tasks_.front();
+            tasks_.pop_front();
+            busy_ = true;
+            lock.unlock();
+            task.reclaim(task.chain, task.context);
+            lock.lock();
+            busy_ = false;
+            if (tasks_.empty()) {
+                idle_.notify_all();
+            }
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable has_work_;
+    std::condition_variable idle_;
+    std::deque<Task> tasks_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread worker_;
+};
@@ -0,0 +1,199 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Двоичный формат списков (SingleLinkedList::Serialize/Deserialize, MappedSingleLinkedList).
+//
+// Файл начинается с заголовка SerializedListHeader. Дальше — одно из двух представлений:
+// * образ (флаг kImage, только для тривиально копируемых Type): с first_offset (выровненного под Type)
+//   подряд идут count значений по record_size == sizeof(Type) байт в порядке списка, как в массиве.
+//   Ссылок между записями нет: следующая всегда лежит сразу за предыдущей.
+//   Такой файл можно отобразить в память и обходить без создания узлов (см. MappedSingleLinkedList);
+// * поток: с first_offset подряд идут count значений, закодированных BinaryCodec<Type>.
+// Числа записываются в порядке байт машины; чужой порядок распознаётся по полю byte_order и отвергается.
+// При несовместимых изменениях формата увеличивается kSerializedListVersion
+
+// 2: записи образа без ссылки next_offset
+constexpr uint32_t kSerializedListVersion = 2;
+
+struct SerializedListHeader {
+    static constexpr char kMagic[4] = {'S', 'L', 'L', 'F'};
+    static constexpr uint32_t kByteOrder = 0x01020304;
+    // Записи лежат образом со ссылками-смещениями
+    static constexpr uint32_t kImage = 1;
+
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t byte_order;
+    uint32_t value_size;
+    uint32_t record_size;
+    uint64_t count;
+    uint64_t first_offset;
+};
+
+
+// Кодирование значений, у которых нет образа (не тривиально копируемых).
+// Для своих типов достаточно специализировать BinaryCodec со статическими Write(std::ostream&, const T&) и Read(std::istream&)
+template <typename T, typename = void>
+struct BinaryCodec;
+
+// Строки: длина (uint64), затем символы
+template <typename Char, typename Traits, typename Alloc>
+struct BinaryCodec<std::basic_string<Char, Traits, Alloc>, std::enable_if_t<std::is_trivially_copyable_v<Char>>> {
+    using String = std::basic_string<Char, Traits, Alloc>;
+
+    static void Write(std::ostream& out, const String& value) {
+        const uint64_t length = value.size();
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(length * sizeof(Char)));
+    }
+
+    static String Read(std::istream& in) {
+        uint64_t length = 0;
+        in.read(reinterpret_cast<char*>(&length), sizeof(length));
+        String value;
+        if (in) {
+            value.resize(static_cast<size_t>(length));
+            in.read(reinterpret_cast<char*>(value.data()), static_cast<std::streamsize>(length * sizeof(Char)));
+        }
+        return value;
+    }
+};
+
+
+namespace serialization_detail {
+
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Раскладка образа: записи — сами значения, sizeof(Type) уже кратен alignof(Type)
+template <typename Type>
+struct ImageLayout {
+    static constexpr uint64_t kRecordSize = sizeof(Type);
+    static constexpr uint64_t kFirstOffset = AlignUp(sizeof(SerializedListHeader), alignof(Type));
+};
+
+// Сколько записей образа читается и пишется за один вызов потока
+constexpr size_t kChunkRecords = 4096;
+
+[[noreturn]] inline void Fail(const char* what) {
+    throw std::runtime_error(std::string("serialized list: ") + what);
+}
+
+template <typename Type>
+SerializedListHeader MakeHeader(uint64_t count) {
+    SerializedListHeader header{};
+    std::memcpy(header.magic, SerializedListHeader::kMagic, sizeof(header.magic));
+    header.version = kSerializedListVersion;
+    header.byte_order = SerializedListHeader::kByteOrder;
+    header.value_size = sizeof(Type);
+    header.count = count;
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        header.flags = SerializedListHeader::kImage;
+        header.record_size = ImageLayout<Type>::kRecordSize;
+        header.first_offset = ImageLayout<Type>::kFirstOffset;
+    } else {
+        header.first_offset = sizeof(SerializedListHeader);
+    }
+    return header;
+}
+
+// Проверяет, что заголовок записан для того же Type и той же версией формата
+template <typename Type>
+void ValidateHeader(const SerializedListHeader& header) {
+    const SerializedListHeader expected = MakeHeader<Type>(0);
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+        Fail("bad magic");
+    }
+    if (header.version != expected.version) {
+        Fail("unsupported version");
+    }
+    if (header.byte_order != expected.byte_order) {
+        Fail("foreign byte order");
+    }
+    if (header.flags != expected.flags || header.value_size != expected.value_size ||
+        header.record_size != expected.record_size || header.first_offset != expected.first_offset) {
+        Fail("value type mismatch");
+    }
+}
+
+// Пишет count элементов из [first, ...) вслед за заголовком
+template <typename Type, typename InputIterator>
+void Write(std::ostream& out, InputIterator first, uint64_t count) {
+    const SerializedListHeader header = MakeHeader<Type>(count);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        using Layout = ImageLayout<Type>;
+        const std::vector<char> padding(Layout::kFirstOffset - sizeof(header), 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        std::vector<char> chunk(Layout::kRecordSize * kChunkRecords, 0);
+        uint64_t written = 0;
+        while (written < count) {
+            const uint64_t in_chunk = std::min<uint64_t>(kChunkRecords, count - written);
+            for (uint64_t i = 0; i < in_chunk; ++i, ++first) {
+                std::memcpy(chunk.data() + i * Layout::kRecordSize, std::addressof(*first), sizeof(Type));
+            }
+            out.write(chunk.data(), static_cast<std::streamsize>(in_chunk * Layout::kRecordSize));
+            written += in_chunk;
+        }
+    } else {
+        for (uint64_t i = 0; i < count; ++i, ++first) {
+            BinaryCodec<Type>::Write(out, *first);
+        }
+    }
+    if (!out) {
+        Fail("write failed");
+    }
+}
+
+// Читает список, передавая значения по порядку в sink(Type&&)
+template <typename Type, typename Sink>
+void Read(std::istream& in, Sink&& sink) {
+    SerializedListHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        Fail("truncated header");
+    }
+    ValidateHeader<Type>(header);
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        using Layout = ImageLayout<Type>;
+        in.ignore(static_cast<std::streamsize>(Layout::kFirstOffset - sizeof(header)));
+
+        std::vector<char> chunk(Layout::kRecordSize * kChunkRecords);
+        uint64_t read = 0;
+        while (read < header.count) {
+            const uint64_t in_chunk = std::min<uint64_t>(kChunkRecords, header.count - read);
+            if (!in.read(chunk.data(), static_cast<std::streamsize>(in_chunk * Layout::kRecordSize))) {
+                Fail("truncated records");
+            }
+            for (uint64_t i = 0; i < in_chunk; ++i) {
+                alignas(Type) unsigned char storage[sizeof(Type)];
+                std::memcpy(storage, chunk.data() + i * Layout::kRecordSize, sizeof(Type));
+                sink(std::move(*std::launder(reinterpret_cast<Type*>(storage))));
+            }
+            read += in_chunk;
+        }
+    } else {
+        for (uint64_t i = 0; i < header.count; ++i) {
+            Type value = BinaryCodec<Type>::Read(in);
+            if (!in) {
+                Fail("truncated value");
+            }
+            sink(std::move(value));
+        }
+    }
+}
+
+}  // namespace serialization_detail
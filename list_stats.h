@@ -0,0 +1,280 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <typeinfo>
+#include <vector>
+
+// Инструментирование списков: сколько узлов выделено и освобождено, сколько шагов сделали итераторы,
+// сколько было вставок, удалений и очисток, каков наибольший размер.
+// Политика передаётся списку шаблонным параметром Stats. По умолчанию (DefaultListStats) это NoListStats,
+// все хуки которой пусты, а сама она и её часть в итераторе не занимают места, — код списка тот же, что без неё.
+// Определение макроса SLL_ENABLE_STATS до подключения заголовков включает CountingListStats для всех списков
+
+// Снимок счётчиков одного списка
+struct ListStats {
+    size_t node_allocations = 0;
+    size_t node_deallocations = 0;
+    // Память, занятая узлами списка сейчас (size * размер узла)
+    size_t bytes_held = 0;
+    // Сколько раз итераторы этого списка сделали ++
+    size_t iterator_steps = 0;
+    size_t insert_calls = 0;
+    size_t erase_calls = 0;
+    size_t clear_calls = 0;
+    // Наибольшее число узлов, освобождённых одним Clear
+    size_t largest_clear = 0;
+    size_t compactions = 0;
+    size_t size = 0;
+    size_t peak_size = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const ListStats& stats) {
+    return out << "size=" << stats.size << " peak_size=" << stats.peak_size << " bytes_held=" << stats.bytes_held
+               << " node_allocations=" << stats.node_allocations << " node_deallocations=" << stats.node_deallocations
+               << " iterator_steps=" << stats.iterator_steps << " insert_calls=" << stats.insert_calls
+               << " erase_calls=" << stats.erase_calls << " clear_calls=" << stats.clear_calls
+               << " largest_clear=" << stats.largest_clear << " compactions=" << stats.compactions;
+}
+
+
+// Тип списка, передаваемый политике при создании. Политика сама решает, вычислять ли typeid(List):
+// NoListStats его не трогает, поэтому список без статистики собирается и без RTTI
+template <typename List>
+struct ListTypeTag {};
+
+// Политика по умолчанию: ничего не считает
+class NoListStats {
+public:
+    static constexpr bool kEnabled = false;
+
+    // Часть итератора, отвечающая за подсчёт шагов
+    class IteratorHook {
+    public:
+        IteratorHook() = default;
+        explicit IteratorHook(const NoListStats*) noexcept {}
+
+        void OnStep() const noexcept {}
+    };
+
+    template <typename List>
+    NoListStats(size_t /*node_bytes*/, ListTypeTag<List> /*list_type*/) noexcept {}
+    NoListStats(const NoListStats&) = delete;
+    NoListStats& operator=(const NoListStats&) = delete;
+
+    void OnAllocate() noexcept {}
+    void OnDeallocate(size_t /*count*/ = 1) noexcept {}
+    void OnInsert() noexcept {}
+    void OnErase() noexcept {}
+    void OnClear(size_t /*count*/) noexcept {}
+    void OnResize(size_t /*size*/) noexcept {}
+    void OnCompact() noexcept {}
+
+    void Swap(NoListStats& /*other*/) noexcept {}
+
+    [[nodiscard]] ListStats GetSnapshot() const noexcept {
+        return {};
+    }
+};
+
+
+class CountingListStats;
+
+// Реестр всех живых списков с CountingListStats — чтобы вывести статистику разом, например при завершении программы.
+// Потокобезопасен. Снимки списков, которые в этот момент меняются другими потоками, могут быть несогласованными
+class ListStatsRegistry {
+public:
+    static ListStatsRegistry& Instance() {
+        static ListStatsRegistry registry;
+        return registry;
+    }
+
+    void Register(const CountingListStats* stats) {
+        std::lock_guard guard(mutex_);
+        lists_.push_back(stats);
+    }
+
+    void Unregister(const CountingListStats* stats) noexcept {
+        std::lock_guard guard(mutex_);
+        lists_.erase(std::remove(lists_.begin(), lists_.end(), stats), lists_.end());
+    }
+
+    [[nodiscard]] size_t GetListCount() const {
+        std::lock_guard guard(mutex_);
+        return lists_.size();
+    }
+
+    // Снимки всех живых списков в порядке их создания
+    [[nodiscard]] std::vector<ListStats> Collect() const;
+
+    // Выводит по строке на каждый живой список
+    void Dump(std::ostream& out) const;
+
+private:
+    ListStatsRegistry() = default;
+
+    mutable std::mutex mutex_;
+    std::vector<const CountingListStats*> lists_;
+};
+
+
+// Политика со счётчиками. Счётчики атомарные (relaxed), так что одновременный обход списка
+// несколькими читателями безопасен. Счётчики лежат в отдельном блоке, который при перемещении и обмене
+// списков (Swap) переезжает вместе с узлами, а итератор считает шаги в блок, а не в объект списка, —
+// поэтому он остаётся действительным, пока живы его узлы, даже если сам список перемещён и уничтожен.
+// SpliceAfter и Merge переносят узлы без счётчиков: итератор, полученный до переноса, засчитывает шаги
+// прежнему списку, и продвигать его после уничтожения того списка нельзя
+class CountingListStats {
+    struct Counters;
+
+public:
+    static constexpr bool kEnabled = true;
+
+    class IteratorHook {
+    public:
+        IteratorHook() = default;
+        explicit IteratorHook(const CountingListStats* stats) noexcept
+            : counters_(stats ? stats->counters_.get() : nullptr) {}
+
+        void OnStep() const noexcept {
+            if (counters_) {
+                counters_->iterator_steps.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+        Counters* counters_ = nullptr;
+    };
+
+    // list_type — тип списка, его имя выводит ListStatsRegistry::Dump
+    CountingListStats(size_t node_bytes, const std::type_info& list_type)
+        : node_bytes_(node_bytes)
+        , list_type_(&list_type) {
+        ListStatsRegistry::Instance().Register(this);
+    }
+
+    // Счётчикам нужен RTTI. Без него (-fno-rtti) этого конструктора нет, и собираются только списки с NoListStats
+#if defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI)
+    template <typename List>
+    CountingListStats(size_t node_bytes, ListTypeTag<List> /*list_type*/)
+        : CountingListStats(node_bytes, typeid(List)) {}
+#endif
+
+    CountingListStats(const CountingListStats&) = delete;
+    CountingListStats& operator=(const CountingListStats&) = delete;
+
+    ~CountingListStats() {
+        ListStatsRegistry::Instance().Unregister(this);
+    }
+
+    void OnAllocate() noexcept {
+        Increment(counters_->node_allocations);
+    }
+
+    void OnDeallocate(size_t count = 1) noexcept {
+        Increment(counters_->node_deallocations, count);
+    }
+
+    void OnInsert() noexcept {
+        Increment(counters_->insert_calls);
+    }
+
+    void OnErase() noexcept {
+        Increment(counters_->erase_calls);
+    }
+
+    void OnClear(size_t count) noexcept {
+        Increment(counters_->clear_calls);
+        if (count > counters_->largest_clear.load(std::memory_order_relaxed)) {
+            counters_->largest_clear.store(count, std::memory_order_relaxed);
+        }
+    }
+
+    void OnCompact() noexcept {
+        Increment(counters_->compactions);
+    }
+
+    // Вызывается после каждого изменения размера списка
+    void OnResize(size_t size) noexcept {
+        counters_->size.store(size, std::memory_order_relaxed);
+        if (size > counters_->peak_size.load(std::memory_order_relaxed)) {
+            counters_->peak_size.store(size, std::memory_order_relaxed);
+        }
+    }
+
+    // Вызывается, когда списки обмениваются цепочками узлов целиком (swap, перемещение)
+    void Swap(CountingListStats& other) noexcept {
+        counters_.swap(other.counters_);
+    }
+
+    [[nodiscard]] ListStats GetSnapshot() const noexcept {
+        ListStats stats;
+        stats.node_allocations = counters_->node_allocations.load(std::memory_order_relaxed);
+        stats.node_deallocations = counters_->node_deallocations.load(std::memory_order_relaxed);
+        stats.iterator_steps = counters_->iterator_steps.load(std::memory_order_relaxed);
+        stats.insert_calls = counters_->insert_calls.load(std::memory_order_relaxed);
+        stats.erase_calls = counters_->erase_calls.load(std::memory_order_relaxed);
+        stats.clear_calls = counters_->clear_calls.load(std::memory_order_relaxed);
+        stats.largest_clear = counters_->largest_clear.load(std::memory_order_relaxed);
+        stats.compactions = counters_->compactions.load(std::memory_order_relaxed);
+        stats.size = counters_->size.load(std::memory_order_relaxed);
+        stats.peak_size = counters_->peak_size.load(std::memory_order_relaxed);
+        stats.bytes_held = stats.size * node_bytes_;
+        return stats;
+    }
+
+    [[nodiscard]] const std::type_info& GetListType() const noexcept {
+        return *list_type_;
+    }
+
+private:
+    // Изменяет список только один поток, поэтому хватает load + store без атомарного RMW
+    static void Increment(std::atomic<size_t>& counter, size_t delta = 1) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    struct Counters {
+        std::atomic<size_t> node_allocations{0};
+        std::atomic<size_t> node_deallocations{0};
+        // Итераторы могут продвигаться одновременно из нескольких читающих потоков
+        std::atomic<size_t> iterator_steps{0};
+        std::atomic<size_t> insert_calls{0};
+        std::atomic<size_t> erase_calls{0};
+        std::atomic<size_t> clear_calls{0};
+        std::atomic<size_t> largest_clear{0};
+        std::atomic<size_t> compactions{0};
+        std::atomic<size_t> size{0};
+        std::atomic<size_t> peak_size{0};
+    };
+
+    size_t node_bytes_;
+    const std::type_info* list_type_;
+    std::unique_ptr<Counters> counters_ = std::make_unique<Counters>();
+};
+
+inline std::vector<ListStats> ListStatsRegistry::Collect() const {
+    std::lock_guard guard(mutex_);
+    std::vector<ListStats> result;
+    result.reserve(lists_.size());
+    for (const CountingListStats* stats : lists_) {
+        result.push_back(stats->GetSnapshot());
+    }
+    return result;
+}
+
+inline void ListStatsRegistry::Dump(std::ostream& out) const {
+    std::lock_guard guard(mutex_);
+    for (const CountingListStats* stats : lists_) {
+        out << stats->GetListType().name() << " @" << static_cast<const void*>(stats) << ": " << stats->GetSnapshot() << '\n';
+    }
+}
+
+
+#ifdef SLL_ENABLE_STATS
+using DefaultListStats = CountingListStats;
+#else
+using DefaultListStats = NoListStats;
+#endif
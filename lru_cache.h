@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "hashed_single_linked_list.h"
+#include "pool_allocator.h"
+
+// Счётчики LruCache. Попадания и промахи считает только Get
+struct LruCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+};
+
+// Кеш на capacity элементов, вытесняющий дольше всех не использованный (LRU).
+// Элементы лежат в HashedSingleLinkedList от самого свежего к самому старому: Get и Put находят элемент по индексу
+// и перевешивают его узел в начало (MoveToFront), а вытесняется последний элемент (PopBack) — всё за O(1) в среднем.
+// Узлы берутся из собственного NodePoolResource: узел вытесненного элемента возвращается в free list пула
+// и тут же занимается следующей вставкой, а таблица индекса с самого начала рассчитана на capacity элементов.
+// Поэтому заполненный кеш не обращается к operator new ни в Get, ни в Put (если этого не делают конструкторы Key и Value).
+// Не потокобезопасен
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class LruCache {
+    using Entry = std::pair<const Key, Value>;
+    using Entries = HashedSingleLinkedList<Key, Value, Hash, KeyEqual, PoolAllocator<Entry>>;
+
+public:
+    using ConstIterator = typename Entries::ConstIterator;
+
+    explicit LruCache(size_t capacity)
+        : capacity_(capacity),
+          entries_(PoolAllocator<Entry>(std::make_shared<NodePoolResource>(std::min(capacity + 1, kMaxSlabSlots)))) {
+        if (capacity == 0) {
+            throw std::invalid_argument("LruCache capacity must be positive");
+        }
+        // Put сначала вставляет новый элемент и только потом вытесняет старый, поэтому на пике элементов на один больше
+        entries_.Reserve(capacity + 1);
+    }
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+    LruCache(LruCache&&) = default;
+    LruCache& operator=(LruCache&&) = default;
+
+    // Обход от самого свежего элемента к самому старому; порядок не меняет
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return entries_.begin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return entries_.end();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return entries_.GetSize();
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return entries_.IsEmpty();
+    }
+
+    [[nodiscard]] size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    [[nodiscard]] LruCacheStats GetStats() const noexcept {
+        return stats_;
+    }
+
+    void ResetStats() noexcept {
+        stats_ = LruCacheStats{};
+    }
+
+    // Пул узлов кеша: по GetSlabCount() видно, брал ли кеш память у системы
+    [[nodiscard]] const NodePoolResource& GetNodePool() const noexcept {
+        return entries_.GetList().GetAllocator().GetResource();
+    }
+
+    // Значение по ключу или nullptr. Найденный элемент становится самым свежим.
+    // Указатель действителен до удаления элемента: Put другого ключа может его вытеснить
+    [[nodiscard]] Value* Get(const Key& key) {
+        if (!entries_.MoveToFront(key)) {
+            ++stats_.misses;
+            return nullptr;
+        }
+        ++stats_.hits;
+        return &entries_.front().second;
+    }
+
+    // Значение по ключу или nullptr, не трогая ни порядок, ни счётчики
+    [[nodiscard]] const Value* Peek(const Key& key) const {
+        const auto it = entries_.Find(key);
+        return it == entries_.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]] bool Contains(const Key& key) const {
+        return entries_.Contains(key);
+    }
+
+    // Записывает значение и делает элемент самым свежим. Если ключа не было и кеш полон, вытесняет самый старый.
+    // При исключении в конструкторе элемента кеш не меняется
+    Value& Put(const Key& key, Value value) {
+        return PutImpl(key, std::move(value));
+    }
+
+    Value& Put(Key&& key, Value value) {
+        return PutImpl(std::move(key), std::move(value));
+    }
+
+    bool Erase(const Key& key) {
+        return entries_.EraseByKey(key);
+    }
+
+    // Удаляет все элементы; узлы остаются в пуле для следующих вставок
+    void Clear() noexcept {
+        entries_.Clear();
+    }
+
+private:
+    // Не больше стольких узлов в одном slab'е пула: у большого кеша память занимается по мере заполнения
+    static constexpr size_t kMaxSlabSlots = 4096;
+
+    template <typename K>
+    Value& PutImpl(K&& key, Value&& value) {
+        if (entries_.MoveToFront(key)) {
+            entries_.front().second = std::move(value);
+            return entries_.front().second;
+        }
+        Value& inserted = entries_.TryEmplaceAfter(entries_.before_begin(), std::forward<K>(key), std::move(value)).first->second;
+        if (entries_.GetSize() > capacity_) {
+            entries_.PopBack();
+            ++stats_.evictions;
+        }
+        return inserted;
+    }
+
+    size_t capacity_;
+    Entries entries_;
+    LruCacheStats stats_;
+};
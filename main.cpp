@@ -28,6 +28,31 @@ int main() {
     */
     Test4(); 
 
+    MyTest_Allocators(); 
+    MyTest_Move_Emplace(); 
+    MyTest_Unrolled(); 
+    MyTest_Splice(); 
+    MyTest_Sort_Merge_Unique(); 
+    MyTest_Concurrent_Stack(); 
+    MyTest_Tail(); 
+    MyTest_Stats(); 
+    MyTest_Compact(); 
+    MyTest_Small(); 
+    MyTest_Intrusive(); 
+    MyTest_Serialization(); 
+    MyTest_Persistent(); 
+    MyTest_Index(); 
+    MyTest_Reclaim(); 
+    MyTest_RangeInsert(); 
+    MyTest_Prefetch(); 
+    MyTest_Parallel(); 
+    MyTest_Positional(); 
+    MyTest_Sorted(); 
+    MyTest_Hashed(); 
+    MyTest_Lru(); 
+    MyTest_ThreadCache(); 
+    MyTest_FineGrained(); 
+
 
 
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "list_serialization.h"
+
+// Список, записанный SingleLinkedList::Serialize, отображённый в память только для чтения (POSIX mmap).
+// Узлы не создаются и не копируются: итератор идёт по записям образа прямо в отображённой памяти,
+// поэтому открытие стоит O(1), а страницы файла подгружаются по мере обхода.
+// Записи образа лежат подряд, как в массиве, поэтому итератор шагает на record_size байт;
+// конструктор проверяет, что count записей умещаются в файле, так что обход не выходит за пределы отображения.
+// Только для тривиально копируемых Type. Файл не должен меняться, пока он отображён
+template <typename Type>
+class MappedSingleLinkedList {
+    static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable values can be mapped");
+
+    using Layout = serialization_detail::ImageLayout<Type>;
+
+public:
+    // Итератор по записям образа. Конец — смещение сразу за последней записью
+    class ConstIterator {
+        friend class MappedSingleLinkedList;
+
+        ConstIterator(const unsigned char* base, uint64_t offset) : base_(base), offset_(offset) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIterator() = default;
+
+        [[nodiscard]] bool operator==(const ConstIterator& rhs) const noexcept {
+            return offset_ == rhs.offset_;
+        }
+
+        [[nodiscard]] bool operator!=(const ConstIterator& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        ConstIterator& operator++() noexcept {
+            offset_ += Layout::kRecordSize;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return *operator->();
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return std::launder(reinterpret_cast<const Type*>(base_ + offset_));
+        }
+
+    private:
+        const unsigned char* base_ = nullptr;
+        uint64_t offset_ = 0;
+    };
+
+    using value_type = Type;
+    using const_reference = const Type&;
+    using Iterator = ConstIterator;
+
+    // Отображает файл path. Бросает std::runtime_error, если файл не открывается
+    // или не является образом списка из Type (другой тип, версия формата, обрезанный файл)
+    explicit MappedSingleLinkedList(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            serialization_detail::Fail("cannot open file");
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < sizeof(SerializedListHeader)) {
+            ::close(fd);
+            serialization_detail::Fail("truncated header");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            serialization_detail::Fail("mmap failed");
+        }
+        data_ = static_cast<const unsigned char*>(data);
+
+        try {
+            std::memcpy(&header_, data_, sizeof(header_));
+            serialization_detail::ValidateHeader<Type>(header_);
+            if (header_.count != 0 && (header_.first_offset > size_ ||
+                                       header_.count > (size_ - header_.first_offset) / Layout::kRecordSize)) {
+                serialization_detail::Fail("truncated records");
+            }
+        } catch (...) {
+            Unmap();
+            throw;
+        }
+    }
+
+    MappedSingleLinkedList(const MappedSingleLinkedList&) = delete;
+    MappedSingleLinkedList& operator=(const MappedSingleLinkedList&) = delete;
+
+    MappedSingleLinkedList(MappedSingleLinkedList&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , header_(other.header_) {
+        other.header_.count = 0;
+    }
+
+    MappedSingleLinkedList& operator=(MappedSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            Unmap();
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+            header_ = rhs.header_;
+            rhs.header_.count = 0;
+        }
+        return *this;
+    }
+
+    ~MappedSingleLinkedList() {
+        Unmap();
+    }
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return ConstIterator(data_, header_.first_offset);
+    }
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return ConstIterator(data_, header_.first_offset + header_.count * Layout::kRecordSize);
+    }
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return static_cast<size_t>(header_.count);
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return header_.count == 0;
+    }
+
+    [[nodiscard]] const_reference front() const noexcept {
+        assert(!IsEmpty());
+        return *begin();
+    }
+
+private:
+    void Unmap() noexcept {
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+            data_ = nullptr;
+        }
+    }
+
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    SerializedListHeader header_{};
+};
@@ -1,9 +1,35 @@
+#include <atomic>
 #include <cassert>
+#include <filesystem>
+#include <fstream>
 #include <string>
+#include <thread>
+#include <algorithm>
 #include <map>
+#include <set>
+#include <random>
+#include <stdexcept>
+#include <vector>
 #include <iostream>
+#include <iterator>
+#include <sstream>
 
 #include "single_linked_list.h"
+#include "pool_allocator.h"
+#include "index_linked_list.h"
+#include "intrusive_single_linked_list.h"
+#include "mapped_single_linked_list.h"
+#include "persistent_single_linked_list.h"
+#include "small_single_linked_list.h"
+#include "unrolled_linked_list.h"
+#include "concurrent_single_linked_list.h"
+#include "parallel_list_algorithms.h"
+#include "positional_single_linked_list.h"
+#include "sorted_single_linked_list.h"
+#include "hashed_single_linked_list.h"
+#include "lru_cache.h"
+#include "thread_node_cache.h"
+#include "fine_grained_single_linked_list.h"
 
 template <typename List>
 void PrintList(const List& list_) {
@@ -209,4 +235,2376 @@ void MyTest_EraseAfter() {
     std::cout << "CHECK: /3rd/ should've just been deleted"s << std::endl; 
 
 
-}
\ No newline at end of file
+}
+
+
+void MyTest_Allocators() {
+    using namespace std::string_literals; 
+
+    // Пул: узлы берутся из общих slab'ов, копии списка делят пул
+    {
+        SingleLinkedList<std::string, PoolAllocator<std::string>> one {"ku"s, "ku"s, "ru"s}; 
+        NodePoolResource& pool = one.GetAllocator().GetResource(); 
+        assert(pool.GetLiveSlots() == 3); 
+
+        auto two = one; 
+        assert(two == one); 
+        assert(pool.GetLiveSlots() == 6); 
+
+        two.PopFront(); 
+        two.PushFront("su"s); 
+        assert(pool.GetLiveSlots() == 6); 
+        assert(*two.begin() == "su"s); 
+
+        two.Clear(); 
+        assert(pool.GetLiveSlots() == 3); 
+    }
+
+    // Для тривиально разрушаемых типов Clear() отдаёт пул целиком, не обходя узлы
+    {
+        SingleLinkedList<int, PoolAllocator<int>> numbers {1, 2, 3, 4}; 
+        NodePoolResource& pool = numbers.GetAllocator().GetResource(); 
+        numbers.Clear(); 
+        assert(pool.GetLiveSlots() == 0); 
+        assert(numbers.IsEmpty()); 
+        numbers.PushFront(5); 
+        assert((numbers == SingleLinkedList<int, PoolAllocator<int>>{5})); 
+    }
+
+    // Присваивание между списками с разными пулами забирает аллокатор источника
+    {
+        SingleLinkedList<int, PoolAllocator<int>> src {1, 2, 3}; 
+        SingleLinkedList<int, PoolAllocator<int>> dst {4, 5}; 
+        dst = src; 
+        assert(dst == src); 
+        assert(dst.GetAllocator() == src.GetAllocator()); 
+        assert(src.GetAllocator().GetResource().GetLiveSlots() == 6); 
+    }
+
+    // std::pmr: все узлы (и служебных копий тоже) живут в переданном ресурсе
+    {
+        NodePoolResource pool; 
+        PmrSingleLinkedList<std::string> one ({"ku"s, "ru"s}, &pool); 
+        PmrSingleLinkedList<std::string> two (&pool); 
+        two.PushFront("su"s); 
+        two = one; 
+        assert(two == one); 
+        assert(pool.GetLiveSlots() == 4); 
+        one.swap(two); 
+        two.Clear(); 
+        assert(pool.GetLiveSlots() == 2); 
+    }
+
+    // Конструктор по умолчанию ничего не выделяет и не требует конструктора по умолчанию у Type
+    {
+        struct NoDefault {
+            explicit NoDefault(int v) : value(v) {}
+            int value; 
+        }; 
+        SingleLinkedList<NoDefault> list; 
+        list.PushFront(NoDefault(1)); 
+        assert(list.begin()->value == 1); 
+    }
+
+    std::cout << "####Allocators are OK" << std::endl;
+}
+
+
+
+void MyTest_Move_Emplace() {
+    using namespace std::string_literals; 
+
+    struct Counters {
+        int copies = 0; 
+        int moves = 0; 
+    }; 
+
+    // Считает свои копирования и перемещения в переданных счётчиках
+    struct CountsCopiesMoves {
+        CountsCopiesMoves(std::string name, Counters& counters) : name_(std::move(name)), counters_(&counters) {}
+        CountsCopiesMoves(const CountsCopiesMoves& other) : name_(other.name_), counters_(other.counters_) { ++counters_->copies; }
+        CountsCopiesMoves(CountsCopiesMoves&& other) noexcept : name_(std::move(other.name_)), counters_(other.counters_) { ++counters_->moves; }
+        CountsCopiesMoves& operator=(const CountsCopiesMoves&) = delete; 
+
+        std::string name_; 
+        Counters* counters_; 
+    }; 
+
+    Counters counters; 
+
+    // Emplace конструирует значение прямо в узле: ни копий, ни перемещений
+    {
+        SingleLinkedList<CountsCopiesMoves> list; 
+        counters = Counters{}; 
+        CountsCopiesMoves& front = list.EmplaceFront("First"s, counters); 
+        auto it = list.EmplaceAfter(list.cbegin(), "Second"s, counters); 
+        list.EmplaceAfter(it, "Third"s, counters); 
+        assert(counters.copies == 0 && counters.moves == 0); 
+        assert(&front == &*list.begin()); 
+        assert(it->name_ == "Second"s); 
+        assert(list.GetSize() == 3); 
+    }
+
+    // rvalue PushFront/InsertAfter только перемещают
+    {
+        SingleLinkedList<CountsCopiesMoves> list; 
+        counters = Counters{}; 
+        list.PushFront(CountsCopiesMoves("First"s, counters)); 
+        list.InsertAfter(list.cbegin(), CountsCopiesMoves("Second"s, counters)); 
+        assert(counters.copies == 0 && counters.moves == 2); 
+    }
+
+    // Перемещение списка забирает узлы, не трогая значения
+    {
+        SingleLinkedList<CountsCopiesMoves> list; 
+        list.EmplaceFront("First"s, counters); 
+        list.EmplaceFront("Second"s, counters); 
+        const auto old_begin = list.begin(); 
+        counters = Counters{}; 
+
+        SingleLinkedList<CountsCopiesMoves> moved(std::move(list)); 
+        assert(moved.begin() == old_begin); 
+        assert(moved.GetSize() == 2); 
+        assert(list.IsEmpty() && list.begin() == list.end()); 
+
+        SingleLinkedList<CountsCopiesMoves> assigned; 
+        assigned.EmplaceFront("Old"s, counters); 
+        assigned = std::move(moved); 
+        assert(assigned.begin() == old_begin); 
+        assert(assigned.GetSize() == 2); 
+        assert(moved.IsEmpty()); 
+        assert(counters.copies == 0 && counters.moves == 0); 
+
+        // Опустевший список остаётся пригодным к работе
+        moved.EmplaceFront("New"s, counters); 
+        assert(moved.GetSize() == 1); 
+    }
+
+    // С разными pmr-ресурсами узлы не забираются, а значения перемещаются
+    {
+        NodePoolResource pool_1; 
+        NodePoolResource pool_2; 
+        PmrSingleLinkedList<std::string> one ({"ku"s, "ru"s}, &pool_1); 
+        PmrSingleLinkedList<std::string> two (&pool_2); 
+        two = std::move(one); 
+        assert((two == PmrSingleLinkedList<std::string>{"ku"s, "ru"s})); 
+        assert(pool_2.GetLiveSlots() == 2); 
+    }
+
+    // Список с пулом, из которого переместили узлы, остаётся привязан к пулу: в него можно вставлять, его можно очистить и разрушить
+    {
+        auto pool = std::make_shared<NodePoolResource>(); 
+        SingleLinkedList<int, PoolAllocator<int>> assigned(PoolAllocator<int>{std::make_shared<NodePoolResource>()}); 
+        {
+            SingleLinkedList<int, PoolAllocator<int>> source(PoolAllocator<int>{pool}); 
+            source.PushBack(1); 
+            auto moved = std::move(source); 
+            source.PushBack(2); 
+            assert(source.GetAllocator() == moved.GetAllocator() && pool->GetLiveSlots() == 2); 
+            source.Clear(); 
+            assert(pool->GetLiveSlots() == 1); 
+
+            source.PushBack(3); 
+            assigned = std::move(source); 
+            assert(assigned.GetAllocator() == moved.GetAllocator()); 
+            source.PushBack(4); 
+            assert(source.GetSize() == 1 && pool->GetLiveSlots() == 3); 
+        }
+        assert(pool->GetLiveSlots() == 1); 
+        assert((assigned == SingleLinkedList<int, PoolAllocator<int>>{3})); 
+    }
+
+    std::cout << "####Move and emplace are OK" << std::endl;
+}
+
+
+
+void MyTest_Unrolled() {
+    using namespace std::string_literals; 
+
+    // Базовые операции на маленьких узлах, чтобы чаще срабатывали разбиение и удаление узлов
+    {
+        UnrolledLinkedList<std::string, 4> list {"a"s, "b"s, "c"s, "d"s, "e"s}; 
+        assert(list.GetSize() == 5); 
+        assert(*list.begin() == "a"s); 
+
+        list.PushFront("z"s); 
+        assert((list == UnrolledLinkedList<std::string, 4>{"z"s, "a"s, "b"s, "c"s, "d"s, "e"s})); 
+
+        auto it = list.InsertAfter(++list.cbegin(), "x"s); 
+        assert(*it == "x"s); 
+        assert((list == UnrolledLinkedList<std::string, 4>{"z"s, "a"s, "x"s, "b"s, "c"s, "d"s, "e"s})); 
+
+        it = list.EraseAfter(list.cbegin()); 
+        assert(*it == "x"s); 
+        list.PopFront(); 
+        assert((list == UnrolledLinkedList<std::string, 4>{"x"s, "b"s, "c"s, "d"s, "e"s})); 
+
+        auto copy = list; 
+        assert(copy == list); 
+        copy.Clear(); 
+        assert(copy.IsEmpty() && copy.begin() == copy.end()); 
+        assert(list.GetSize() == 5); 
+    }
+
+    // Случайные вставки и удаления сверяем с std::vector
+    {
+        UnrolledLinkedList<int, 4> list; 
+        std::vector<int> model; 
+        unsigned seed = 12345; 
+        auto next_random = [&seed]() {
+            seed = seed * 1103515245u + 12345u; 
+            return seed >> 16; 
+        }; 
+        for (int step = 0; step < 5000; ++step) {
+            const size_t pos = model.empty() ? 0 : next_random() % (model.size() + 1); 
+            auto it = list.before_begin(); 
+            for (size_t i = 0; i < pos; ++i) {
+                ++it; 
+            }
+            if (next_random() % 3 != 0 || pos == model.size()) {
+                list.InsertAfter(it, step); 
+                model.insert(model.begin() + pos, step); 
+            } else {
+                list.EraseAfter(it); 
+                model.erase(model.begin() + pos); 
+            }
+            assert(list.GetSize() == model.size()); 
+        }
+        assert(std::equal(list.begin(), list.end(), model.begin(), model.end())); 
+    }
+
+    // После удаления 7 из каждых 8 элементов узлы сливаются: заполнены хотя бы наполовину, кроме, может быть, последнего
+    {
+        using List = UnrolledLinkedList<int, 16>; 
+        List list; 
+        auto it = list.before_begin(); 
+        for (int i = 0; i < 8000; ++i) {
+            it = list.InsertAfter(it, i); 
+        }
+        const size_t full_nodes = list.GetNodeCount(); 
+        auto pos = list.before_begin(); 
+        for (int i = 0; i < 8000; ++i) {
+            if (i % 8 == 0) {
+                ++pos; 
+            } else {
+                const auto next = list.EraseAfter(pos); 
+                assert(next == std::next(pos)); 
+            }
+        }
+        assert(list.GetSize() == 1000); 
+        std::vector<int> expected; 
+        for (int i = 0; i < 8000; i += 8) {
+            expected.push_back(i); 
+        }
+        assert(std::equal(list.begin(), list.end(), expected.begin(), expected.end())); 
+        const size_t max_nodes = (list.GetSize() + List::kNodeCapacity / 2 - 1) / (List::kNodeCapacity / 2) + 1; 
+        assert(list.GetNodeCount() <= max_nodes && list.GetNodeCount() < full_nodes / 4); 
+    }
+
+    std::cout << "####Unrolled list is OK" << std::endl;
+}
+
+
+
+void MyTest_Splice() {
+    using IntList = SingleLinkedList<int>; 
+
+    // Перенос целого списка
+    {
+        IntList one {1, 2, 5}; 
+        IntList two {3, 4}; 
+        const auto moved_begin = two.begin(); 
+        one.SpliceAfter(++one.cbegin(), two); 
+        assert((one == IntList{1, 2, 3, 4, 5})); 
+        assert(one.GetSize() == 5); 
+        assert(two.IsEmpty() && two.begin() == two.end()); 
+        // Узлы не копировались
+        assert(++(++one.begin()) == moved_begin); 
+
+        IntList empty; 
+        one.SpliceAfter(one.cbefore_begin(), empty); 
+        assert(one.GetSize() == 5); 
+    }
+
+    // Перенос интервала (first, last)
+    {
+        IntList one {1, 5}; 
+        IntList two {0, 2, 3, 4, 6}; 
+        auto last = two.cbegin(); 
+        for (int i = 0; i < 4; ++i) {
+            ++last; 
+        }
+        one.SpliceAfter(one.cbegin(), two, two.cbegin(), last); 
+        assert((one == IntList{1, 2, 3, 4, 5})); 
+        assert((two == IntList{0, 6})); 
+        assert(one.GetSize() == 5 && two.GetSize() == 2); 
+
+        // Перенос в пределах одного списка: размер не меняется
+        one.SpliceAfter(one.cbefore_begin(), one, ++one.cbegin(), one.cend()); 
+        assert((one == IntList{3, 4, 5, 1, 2})); 
+        assert(one.GetSize() == 5); 
+    }
+
+    // Разрезание и склейка
+    {
+        IntList list {1, 2, 3, 4, 5}; 
+        IntList tail = list.SplitAfter(++list.cbegin()); 
+        assert((list == IntList{1, 2})); 
+        assert((tail == IntList{3, 4, 5})); 
+        assert(list.GetSize() == 2 && tail.GetSize() == 3); 
+
+        IntList whole = list.SplitAfter(list.cbefore_begin()); 
+        assert(list.IsEmpty()); 
+        assert(whole.GetSize() == 2); 
+
+        whole.Append(std::move(tail)); 
+        assert((whole == IntList{1, 2, 3, 4, 5})); 
+        assert(tail.IsEmpty()); 
+
+        list.Append(std::move(whole)); 
+        assert((list == IntList{1, 2, 3, 4, 5})); 
+        assert(list.GetSize() == 5); 
+    }
+
+    std::cout << "####Splice is OK" << std::endl;
+}
+
+
+
+void MyTest_Sort_Merge_Unique() {
+    using IntList = SingleLinkedList<int>; 
+
+    // Сортировка только перевешивает узлы: итераторы продолжают указывать на те же значения
+    {
+        IntList list {5, 3, 9, 1, 7, 3, 0}; 
+        const auto nine = ++(++list.begin()); 
+        list.Sort(); 
+        assert((list == IntList{0, 1, 3, 3, 5, 7, 9})); 
+        assert(list.GetSize() == 7); 
+        assert(*nine == 9); 
+
+        list.Sort(std::greater<>()); 
+        assert((list == IntList{9, 7, 5, 3, 3, 1, 0})); 
+
+        IntList empty; 
+        empty.Sort(); 
+        assert(empty.IsEmpty()); 
+    }
+
+    // Устойчивость: равные по ключу элементы сохраняют исходный порядок
+    {
+        std::vector<std::pair<int, int>> model; 
+        SingleLinkedList<std::pair<int, int>> list; 
+        unsigned seed = 42; 
+        for (int i = 0; i < 1000; ++i) {
+            seed = seed * 1103515245u + 12345u; 
+            model.push_back({static_cast<int>((seed >> 16) % 10), i}); 
+        }
+        for (auto it = model.rbegin(); it != model.rend(); ++it) {
+            list.PushFront(*it); 
+        }
+        auto by_key = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }; 
+        list.Sort(by_key); 
+        std::stable_sort(model.begin(), model.end(), by_key); 
+        assert(std::equal(list.begin(), list.end(), model.begin(), model.end())); 
+    }
+
+    // Исключение в компараторе не теряет элементы
+    {
+        IntList list {5, 4, 3, 2, 1, 0}; 
+        int calls = 0; 
+        try {
+            list.Sort([&calls](int lhs, int rhs) {
+                if (++calls == 4) {
+                    throw std::logic_error("compare"); 
+                }
+                return lhs < rhs; 
+            }); 
+            assert(false); 
+        } catch (const std::logic_error&) {
+            std::vector<int> values(list.begin(), list.end()); 
+            std::sort(values.begin(), values.end()); 
+            assert((values == std::vector<int>{0, 1, 2, 3, 4, 5})); 
+            assert(list.GetSize() == 6); 
+        }
+    }
+
+    // Слияние двух отсортированных списков
+    {
+        IntList one {1, 3, 5, 7}; 
+        IntList two {2, 3, 6}; 
+        one.Merge(two); 
+        assert((one == IntList{1, 2, 3, 3, 5, 6, 7})); 
+        assert(one.GetSize() == 7); 
+        assert(two.IsEmpty()); 
+    }
+
+    // Удаление
+    {
+        IntList list {1, 1, 2, 3, 3, 3, 1, 4}; 
+        assert(list.Unique() == 3); 
+        assert((list == IntList{1, 2, 3, 1, 4})); 
+        assert(list.RemoveIf([](int value) { return value % 2 == 1; }) == 3); 
+        assert((list == IntList{2, 4})); 
+        assert(list.Remove(4) == 1); 
+        assert((list == IntList{2})); 
+        assert(list.GetSize() == 1); 
+    }
+
+    std::cout << "####Sort, Merge and Unique are OK" << std::endl;
+}
+
+
+
+void MyTest_Concurrent_Stack() {
+    // Однопоточная семантика стека
+    {
+        ConcurrentSingleLinkedList<std::string> stack; 
+        assert(stack.IsEmpty()); 
+        assert(!stack.PopFront().has_value()); 
+        stack.PushFront("ku"s); 
+        stack.EmplaceFront(2, 'r'); 
+        assert(!stack.IsEmpty()); 
+        assert(*stack.PopFront() == "rr"s); 
+        assert(*stack.PopFront() == "ku"s); 
+        assert(stack.IsEmpty()); 
+    }
+
+    // Стресс: потоки одновременно кладут и снимают элементы.
+    // Каждое положенное значение должно быть снято ровно один раз
+    {
+        constexpr int kThreads = 8; 
+        constexpr int kPerThread = 20000; 
+        ConcurrentSingleLinkedList<int> stack; 
+        std::vector<std::vector<int>> popped(kThreads); 
+        std::vector<std::thread> threads; 
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&stack, &popped, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    stack.PushFront(t * kPerThread + i); 
+                    if (i % 2 == 1) {
+                        for (int j = 0; j < 2; ++j) {
+                            if (auto value = stack.PopFront()) {
+                                popped[t].push_back(*value); 
+                            }
+                        }
+                    }
+                }
+            }); 
+        }
+        for (auto& thread : threads) {
+            thread.join(); 
+        }
+        std::vector<int> all; 
+        for (const auto& values : popped) {
+            all.insert(all.end(), values.begin(), values.end()); 
+        }
+        while (auto value = stack.PopFront()) {
+            all.push_back(*value); 
+        }
+        std::sort(all.begin(), all.end()); 
+        assert(all.size() == static_cast<size_t>(kThreads * kPerThread)); 
+        for (int i = 0; i < kThreads * kPerThread; ++i) {
+            assert(all[i] == i); 
+        }
+    }
+
+    std::cout << "####Concurrent stack is OK" << std::endl;
+}
+
+
+
+void MyTest_Tail() {
+    using IntList = SingleLinkedList<int>; 
+
+    // before_end() должен указывать на последний элемент (или на before_begin() у пустого списка)
+    auto tail_is_consistent = [](const IntList& list) {
+        auto last = list.cbefore_begin(); 
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            last = it; 
+        }
+        return last == list.cbefore_end(); 
+    }; 
+
+    // Очередь FIFO
+    {
+        IntList queue; 
+        assert(queue.before_end() == queue.before_begin()); 
+        for (int i = 0; i < 5; ++i) {
+            queue.PushBack(i); 
+            assert(queue.back() == i); 
+        }
+        assert(queue.front() == 0); 
+        for (int i = 0; i < 5; ++i) {
+            assert(queue.front() == i); 
+            queue.PopFront(); 
+            assert(tail_is_consistent(queue)); 
+        }
+        assert(queue.IsEmpty()); 
+        queue.EmplaceBack(7); 
+        assert(queue.front() == 7 && queue.back() == 7); 
+    }
+
+    // Хвост не теряется при вставках, удалениях, обмене и перемещении
+    {
+        IntList list {1, 2, 3}; 
+        assert(tail_is_consistent(list)); 
+        list.InsertAfter(list.cbefore_end(), 4); 
+        assert(list.back() == 4); 
+        list.EraseAfter(++(++list.cbegin())); 
+        assert(list.back() == 3); 
+        assert(tail_is_consistent(list)); 
+
+        IntList empty; 
+        list.swap(empty); 
+        assert(tail_is_consistent(list) && tail_is_consistent(empty)); 
+        list.PushBack(10); 
+        empty.PushBack(20); 
+        assert((list == IntList{10})); 
+        assert((empty == IntList{1, 2, 3, 20})); 
+
+        IntList moved(std::move(empty)); 
+        assert(tail_is_consistent(moved) && tail_is_consistent(empty)); 
+        empty.PushBack(1); 
+        assert((empty == IntList{1})); 
+
+        IntList copy = moved; 
+        copy.PushBack(30); 
+        assert((copy == IntList{1, 2, 3, 20, 30})); 
+
+        copy.Clear(); 
+        assert(tail_is_consistent(copy)); 
+    }
+
+    // Хвост после перевешивания узлов
+    {
+        IntList one {1, 2}; 
+        IntList two {3, 4}; 
+        one.SpliceAfter(one.cbefore_end(), two); 
+        assert(one.back() == 4 && tail_is_consistent(two)); 
+
+        IntList tail = one.SplitAfter(++one.cbegin()); 
+        assert(one.back() == 2 && tail.back() == 4); 
+
+        one.SpliceAfter(one.cbegin(), tail, tail.cbegin(), tail.cend()); 
+        assert((one == IntList{1, 4, 2}) && tail_is_consistent(one)); 
+        assert((tail == IntList{3}) && tail_is_consistent(tail)); 
+
+        one.Append(std::move(tail)); 
+        assert(one.back() == 3); 
+
+        one.Sort(); 
+        assert(one.back() == 4 && tail_is_consistent(one)); 
+
+        IntList other {0, 5}; 
+        one.Merge(other); 
+        assert(one.back() == 5 && tail_is_consistent(one) && tail_is_consistent(other)); 
+
+        one.RemoveIf([](int value) { return value > 3; }); 
+        assert(one.back() == 3 && tail_is_consistent(one)); 
+        one.PushBack(3); 
+        one.Unique(); 
+        assert(one.back() == 3 && tail_is_consistent(one)); 
+    }
+
+    std::cout << "####Tail is OK" << std::endl;
+}
+
+void MyTest_Stats() {
+    using CountedList = SingleLinkedList<int, std::allocator<int>, CountingListStats>; 
+
+    // Выключенная статистика не занимает места ни в списке, ни в итераторе
+    {
+        using PlainList = SingleLinkedList<int, std::allocator<int>, NoListStats>; 
+        static_assert(sizeof(PlainList::Iterator) == sizeof(void*)); 
+        struct ListWithoutStats {
+            void* head; 
+            void* tail; 
+            size_t size; 
+            size_t structure_version; 
+            std::allocator<int> alloc; 
+        }; 
+        static_assert(sizeof(PlainList) == sizeof(ListWithoutStats)); 
+        PlainList list {1, 2}; 
+        assert(list.GetStats().node_allocations == 0); 
+    }
+
+    {
+        const size_t lists_before = ListStatsRegistry::Instance().GetListCount(); 
+        CountedList list; 
+        assert(ListStatsRegistry::Instance().GetListCount() == lists_before + 1); 
+
+        for (int i = 0; i < 5; ++i) {
+            list.PushFront(i); 
+        }
+        list.InsertAfter(list.begin(), 10); 
+        list.EraseAfter(list.before_begin()); 
+        list.PopFront(); 
+
+        ListStats stats = list.GetStats(); 
+        assert(stats.node_allocations == 6 && stats.node_deallocations == 2); 
+        assert(stats.insert_calls == 6 && stats.erase_calls == 2); 
+        assert(stats.size == 4 && stats.peak_size == 6); 
+        assert(stats.bytes_held > 4 * sizeof(int)); 
+
+        size_t steps = 0; 
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            ++steps; 
+        }
+        assert(list.GetStats().iterator_steps == steps); 
+
+        list.Clear(); 
+        stats = list.GetStats(); 
+        assert(stats.clear_calls == 1 && stats.largest_clear == 4); 
+        assert(stats.node_deallocations == 6 && stats.size == 0 && stats.bytes_held == 0); 
+
+        // Счётчики переезжают вместе с узлами
+        CountedList other {1, 2, 3}; 
+        list.swap(other); 
+        assert(list.GetStats().size == 3 && other.GetStats().size == 0); 
+        assert(list.GetStats().node_allocations == 3 && other.GetStats().node_allocations == 6); 
+
+        // Итератор переживает перемещение и уничтожение списка, из которого получен, и считает шаги новому владельцу узлов
+        CountedList::ConstIterator it; 
+        CountedList moved; 
+        {
+            CountedList source {4, 5, 6}; 
+            it = source.cbegin(); 
+            CountedList temp(std::move(source)); 
+            moved.swap(temp); 
+        }
+        ++it; 
+        ++it; 
+        assert(*it == 6); 
+        assert(moved.GetStats().iterator_steps == 2 && moved.GetStats().node_allocations == 3); 
+
+        std::ostringstream dump; 
+        ListStatsRegistry::Instance().Dump(dump); 
+        assert(dump.str().find("peak_size=6") != std::string::npos); 
+    }
+    assert(ListStatsRegistry::Instance().Collect().empty()); 
+
+    std::cout << "####Stats is OK" << std::endl;
+}
+
+void MyTest_Compact() {
+    std::mt19937 generator(7); 
+
+    // После сортировки случайных чисел узлы идут в памяти вразброс; Compact возвращает их в порядок обхода
+    {
+        using PoolList = SingleLinkedList<int, PoolAllocator<int>>; 
+        PoolList list; 
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(static_cast<int>(generator() % 10000)); 
+        }
+        list.Sort(); 
+        const std::vector<int> expected(list.begin(), list.end()); 
+        assert(list.GetFragmentation() > 0.5); 
+
+        list.Compact(); 
+        assert(std::vector<int>(list.begin(), list.end()) == expected); 
+        assert(list.GetSize() == 1000 && list.back() == expected.back()); 
+        assert(list.GetFragmentation() == 0.0); 
+        assert(list.GetAllocator().GetResource().GetLiveSlots() == 1000); 
+
+        // Все узлы — в одном блоке с постоянным шагом
+        const int* prev = &list.front(); 
+        const std::ptrdiff_t stride = reinterpret_cast<const char*>(&*(++list.cbegin())) - reinterpret_cast<const char*>(prev); 
+        for (auto it = ++list.cbegin(); it != list.cend(); ++it) {
+            assert(reinterpret_cast<const char*>(&*it) - reinterpret_cast<const char*>(prev) == stride); 
+            prev = &*it; 
+        }
+
+        // Список остаётся рабочим: удаления возвращают узлы из блока по одному
+        list.RemoveIf([](int value) { return value % 2 == 0; }); 
+        list.PushBack(1); 
+        assert(list.back() == 1); 
+        assert(!list.CompactIfFragmented(0.99)); 
+    }
+
+    {
+        SingleLinkedList<std::string> list; 
+        for (int i = 0; i < 100; ++i) {
+            list.PushFront(std::to_string(generator())); 
+        }
+        list.Sort(); 
+        const std::vector<std::string> expected(list.begin(), list.end()); 
+        const bool compacted = list.CompactIfFragmented(0.0); 
+        assert(compacted && std::vector<std::string>(list.begin(), list.end()) == expected); 
+        list.PushBack("tail"s); 
+        assert(list.back() == "tail"s); 
+
+        SingleLinkedList<std::string> one {"single"s}; 
+        one.Compact(); 
+        assert((one == SingleLinkedList<std::string>{"single"s})); 
+    }
+
+    // Если копирование значения бросит исключение, список не меняется
+    {
+        struct ThrowsOnCopy {
+            explicit ThrowsOnCopy(int v) : value(v) {}
+            ThrowsOnCopy(const ThrowsOnCopy& other) : value(other.value) {
+                if (value == 3) {
+                    throw std::runtime_error("copy"); 
+                }
+            }
+            // Перемещение не noexcept, поэтому Compact копирует
+            ThrowsOnCopy(ThrowsOnCopy&& other) : value(other.value) {}
+
+            int value; 
+        }; 
+        SingleLinkedList<ThrowsOnCopy> list; 
+        for (int i = 5; i > 0; --i) {
+            list.EmplaceFront(i); 
+        }
+        const int* first = &list.front().value; 
+        try {
+            list.Compact(); 
+            assert(false); 
+        } catch (const std::runtime_error&) {
+        }
+        assert(list.GetSize() == 5 && &list.front().value == first); 
+        int expected = 1; 
+        for (const ThrowsOnCopy& item : list) {
+            assert(item.value == expected++); 
+        }
+    }
+
+    // Уплотнение видно в статистике
+    {
+        SingleLinkedList<int, std::allocator<int>, CountingListStats> list {3, 1, 2}; 
+        list.Compact(); 
+        const ListStats stats = list.GetStats(); 
+        assert(stats.compactions == 1 && stats.node_allocations == 6 && stats.node_deallocations == 3); 
+    }
+
+    std::cout << "####Compact is OK" << std::endl;
+}
+
+void MyTest_Small() {
+    using SmallList = SmallSingleLinkedList<std::string, 4>; 
+
+    // Первые N узлов лежат в самом объекте списка, следующие — в куче
+    {
+        SmallList list; 
+        assert(list.IsEmpty() && list.begin() == list.end()); 
+        for (int i = 0; i < 4; ++i) {
+            list.PushBack(std::to_string(i)); 
+        }
+        for (auto it = list.cbegin(); it != list.cend(); ++it) {
+            assert(list.IsInline(it)); 
+        }
+        auto fifth = list.InsertAfter(list.cbefore_end(), "4"s); 
+        assert(!list.IsInline(fifth)); 
+
+        // Освободившееся место в буфере используется снова
+        list.PopFront(); 
+        list.PushFront("new"s); 
+        assert(list.IsInline(list.cbegin())); 
+        list.EraseAfter(list.cbefore_begin()); 
+        list.EmplaceAfter(list.cbegin(), 3, 'x'); 
+        assert(list.IsInline(++list.cbegin())); 
+
+        std::vector<std::string> values(list.begin(), list.end()); 
+        assert((values == std::vector<std::string>{"1"s, "xxx"s, "2"s, "3"s, "4"s})); 
+        assert(list.GetSize() == 5 && list.front() == "1"s && list.back() == "4"s); 
+    }
+
+    // Копирование, перемещение и обмен — поэлементные, узлы каждого списка остаются в его буфере
+    {
+        SmallList one {"a"s, "b"s}; 
+        SmallList copy = one; 
+        assert(copy == one && copy.IsInline(copy.cbegin())); 
+
+        SmallList moved(std::move(copy)); 
+        assert(moved == one && copy.IsEmpty()); 
+        assert(moved.IsInline(moved.cbegin())); 
+
+        SmallList big {"1"s, "2"s, "3"s, "4"s, "5"s, "6"s}; 
+        one.swap(big); 
+        assert(one.GetSize() == 6 && big.GetSize() == 2); 
+        assert(big.IsInline(big.cbegin()) && one.IsInline(one.cbegin())); 
+        assert((big == SmallList{"a"s, "b"s})); 
+        assert(one < big && one != big); 
+
+        big = one; 
+        assert(big == one); 
+        one = SmallList{"z"s}; 
+        assert(one.GetSize() == 1 && one.IsInline(one.cbegin())); 
+        assert(one > big); 
+    }
+
+    // Операции над одним списком работают как у SingleLinkedList
+    {
+        SmallSingleLinkedList<int> list {5, 1, 4, 1, 3}; 
+        list.Sort(); 
+        list.Unique(); 
+        list.RemoveIf([](int value) { return value == 4; }); 
+        assert((list == SmallSingleLinkedList<int>{1, 3, 5})); 
+    }
+
+    std::cout << "####Small list is OK" << std::endl;
+}
+
+void MyTest_Intrusive() {
+    // Один и тот же объект состоит сразу в двух списках — по крючку на каждый
+    struct Task {
+        explicit Task(int id) : id(id) {}
+
+        int id; 
+        IntrusiveListHook by_arrival; 
+        IntrusiveListHook by_priority; 
+    }; 
+    using ArrivalList = IntrusiveSingleLinkedList<Task, &Task::by_arrival>; 
+    using PriorityList = IntrusiveSingleLinkedList<Task, &Task::by_priority>; 
+
+    {
+        std::vector<Task> tasks; 
+        for (int i = 0; i < 5; ++i) {
+            tasks.emplace_back(i); 
+        }
+        ArrivalList arrival; 
+        PriorityList priority; 
+        for (Task& task : tasks) {
+            arrival.PushBack(task); 
+            priority.PushFront(task); 
+        }
+        assert(arrival.GetSize() == 5 && priority.GetSize() == 5); 
+        // Элементы — сами объекты, без копий
+        assert(&arrival.front() == &tasks[0] && &priority.front() == &tasks[4]); 
+        assert(&arrival.back() == &tasks[4] && &priority.back() == &tasks[0]); 
+
+        std::vector<int> ids; 
+        for (const Task& task : priority) {
+            ids.push_back(task.id); 
+        }
+        assert((ids == std::vector<int>{4, 3, 2, 1, 0})); 
+
+        // Удаление из одного списка не трогает другой
+        arrival.EraseAfter(arrival.IteratorTo(tasks[1])); 
+        arrival.PopFront(); 
+        assert(arrival.GetSize() == 3 && &arrival.front() == &tasks[1]); 
+        assert(priority.GetSize() == 5); 
+
+        // Вставка после произвольного объекта и в конец
+        auto it = arrival.InsertAfter(arrival.IteratorTo(tasks[1]), tasks[0]); 
+        assert(&*it == &tasks[0] && it->id == 0); 
+        arrival.EraseAfter(arrival.cbefore_begin()); 
+        arrival.PushBack(tasks[1]); 
+        ids.clear(); 
+        for (const Task& task : arrival) {
+            ids.push_back(task.id); 
+        }
+        assert((ids == std::vector<int>{0, 3, 4, 1})); 
+        assert(&arrival.back() == &tasks[1]); 
+
+        ArrivalList moved(std::move(arrival)); 
+        assert(arrival.IsEmpty() && moved.GetSize() == 4); 
+        arrival.PushBack(tasks[2]); 
+        assert(arrival.GetSize() == 1 && &arrival.back() == &tasks[2]); 
+        arrival.swap(moved); 
+        assert(arrival.GetSize() == 4 && moved.GetSize() == 1); 
+    }
+
+    // Владеющий список удаляет объекты сам
+    {
+        int deleted = 0; 
+        struct Owned {
+            explicit Owned(int* counter) : counter(counter) {}
+            ~Owned() {
+                ++*counter; 
+            }
+
+            int* counter; 
+            IntrusiveListHook hook; 
+        }; 
+        {
+            IntrusiveSingleLinkedList<Owned, &Owned::hook, IntrusiveDeleteDisposer> list; 
+            for (int i = 0; i < 4; ++i) {
+                list.PushFront(*new Owned(&deleted)); 
+            }
+            list.PopFront(); 
+            assert(deleted == 1 && list.GetSize() == 3); 
+        }
+        assert(deleted == 4); 
+    }
+
+    // Объект с виртуальной базой (не standard layout): крючок находит свой объект
+    {
+        struct Named {
+            virtual ~Named() = default; 
+            std::string name; 
+        }; 
+        struct Item : virtual Named {
+            explicit Item(int id) : id(id) {
+                name = std::to_string(id); 
+            }
+
+            int id; 
+            IntrusiveListHook hook; 
+        }; 
+        std::vector<Item> items; 
+        items.reserve(3); 
+        for (int i = 0; i < 3; ++i) {
+            items.emplace_back(i); 
+        }
+        IntrusiveSingleLinkedList<Item, &Item::hook> list; 
+        for (Item& item : items) {
+            list.PushFront(item); 
+        }
+        assert(&list.front() == &items[2] && list.front().name == "2"s && list.back().id == 0); 
+        assert(&*std::next(list.begin()) == &items[1]); 
+    }
+
+    std::cout << "####Intrusive list is OK" << std::endl;
+}
+
+void MyTest_Serialization() {
+    // Тривиально копируемые значения пишутся образом
+    {
+        SingleLinkedList<int> list; 
+        for (int i = 0; i < 10000; ++i) {
+            list.PushBack(i * 3); 
+        }
+        std::stringstream stream; 
+        list.Serialize(stream); 
+        assert(stream.str().size() == serialization_detail::ImageLayout<int>::kFirstOffset + 10000 * sizeof(int)); 
+        const SingleLinkedList<int> loaded = SingleLinkedList<int>::Deserialize(stream); 
+        assert(loaded == list && loaded.back() == list.back()); 
+
+        std::stringstream empty_stream; 
+        SingleLinkedList<int>().Serialize(empty_stream); 
+        assert(SingleLinkedList<int>::Deserialize(empty_stream).IsEmpty()); 
+    }
+
+    // Остальные — через BinaryCodec
+    {
+        const SingleLinkedList<std::string> list {"alpha"s, ""s, "a much longer string than the small buffer"s}; 
+        std::stringstream stream; 
+        list.Serialize(stream); 
+        assert(SingleLinkedList<std::string>::Deserialize(stream) == list); 
+    }
+
+    // Повреждённые и чужие данные отвергаются
+    {
+        auto throws = [](const std::string& bytes, auto tag) {
+            using List = typename decltype(tag)::type; 
+            std::stringstream stream(bytes); 
+            try {
+                (void)List::Deserialize(stream); 
+            } catch (const std::runtime_error&) {
+                return true; 
+            }
+            return false; 
+        }; 
+        std::stringstream stream; 
+        SingleLinkedList<int>{1, 2, 3}.Serialize(stream); 
+        const std::string bytes = stream.str(); 
+
+        assert(throws(bytes, std::common_type<SingleLinkedList<double>>())); 
+        assert(throws(bytes.substr(0, bytes.size() - 1), std::common_type<SingleLinkedList<int>>())); 
+        assert(throws(bytes.substr(0, 10), std::common_type<SingleLinkedList<int>>())); 
+        std::string bad_magic = bytes; 
+        bad_magic[0] = 'X'; 
+        assert(throws(bad_magic, std::common_type<SingleLinkedList<int>>())); 
+        std::string bad_version = bytes; 
+        bad_version[4] = 99; 
+        assert(throws(bad_version, std::common_type<SingleLinkedList<int>>())); 
+    }
+
+    // Образ отображается в память и обходится без создания узлов
+    {
+        struct Point {
+            double x; 
+            int y; 
+
+            bool operator==(const Point& other) const {
+                return x == other.x && y == other.y; 
+            }
+        }; 
+        SingleLinkedList<Point> list; 
+        for (int i = 0; i < 1000; ++i) {
+            list.PushBack(Point{i * 0.5, -i}); 
+        }
+        const std::string path = (std::filesystem::temp_directory_path() / "single_linked_list_test.bin").string(); 
+        {
+            std::ofstream out(path, std::ios::binary); 
+            list.Serialize(out); 
+        }
+        {
+            MappedSingleLinkedList<Point> mapped(path); 
+            assert(mapped.GetSize() == 1000 && mapped.front() == list.front()); 
+            assert(std::equal(mapped.begin(), mapped.end(), list.begin(), list.end())); 
+
+            MappedSingleLinkedList<Point> moved(std::move(mapped)); 
+            assert(moved.GetSize() == 1000 && mapped.IsEmpty() && mapped.begin() == mapped.end()); 
+        }
+        // Записи образа — сами значения, без ссылок: файл занимает заголовок и sizeof(Point) байт на элемент.
+        // Файл, обрезанный посреди записей, отвергается сразу
+        {
+            std::string bytes; 
+            {
+                std::ifstream in(path, std::ios::binary); 
+                bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()); 
+            }
+            assert(bytes.size() == serialization_detail::ImageLayout<Point>::kFirstOffset + 1000 * sizeof(Point)); 
+            {
+                std::ofstream out(path, std::ios::binary); 
+                out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2)); 
+            }
+            try {
+                MappedSingleLinkedList<Point> truncated(path); 
+                assert(false); 
+            } catch (const std::runtime_error&) {
+            }
+        }
+        {
+            std::ofstream out(path, std::ios::binary); 
+            SingleLinkedList<Point>().Serialize(out); 
+        }
+        assert(MappedSingleLinkedList<Point>(path).IsEmpty()); 
+        try {
+            MappedSingleLinkedList<int> wrong_type(path); 
+            assert(false); 
+        } catch (const std::runtime_error&) {
+        }
+        std::filesystem::remove(path); 
+    }
+
+    std::cout << "####Serialization is OK" << std::endl;
+}
+
+void MyTest_Persistent() {
+    using List = PersistentSingleLinkedList<std::string>; 
+
+    // Новые версии разделяют хвост со старыми, старые не меняются
+    {
+        const List empty; 
+        const List one = empty.PushFront("one"s); 
+        const List two = one.PushFront("two"s); 
+        const List other_two = one.EmplaceFront(3, 'x'); 
+        assert(empty.IsEmpty() && one.GetSize() == 1 && two.GetSize() == 2); 
+        assert((two == List{"two"s, "one"s}) && (other_two == List{"xxx"s, "one"s})); 
+        assert(&*(++two.begin()) == &one.front() && &*(++other_two.begin()) == &one.front()); 
+
+        const List popped = two.PopFront(); 
+        assert(popped.SharesNodesWith(one) && popped == one); 
+        assert(two.GetSize() == 2 && two.front() == "two"s); 
+
+        List copy = two; 
+        assert(copy.SharesNodesWith(two)); 
+        copy = copy.PopFront().PopFront(); 
+        assert(copy.IsEmpty() && two.GetSize() == 2); 
+        copy = other_two; 
+        assert(copy == other_two && copy != two && two < copy); 
+    }
+
+    // Длинная цепочка освобождается без рекурсии
+    {
+        PersistentSingleLinkedList<int> list; 
+        for (int i = 0; i < 1000000; ++i) {
+            list = list.PushFront(i); 
+        }
+        const auto half = [&list] {
+            auto version = list; 
+            for (int i = 0; i < 500000; ++i) {
+                version = version.PopFront(); 
+            }
+            return version; 
+        }(); 
+        list = PersistentSingleLinkedList<int>(); 
+        assert(half.GetSize() == 500000 && half.front() == 499999); 
+    }
+
+    // Версии с общими узлами копируются и уничтожаются из разных потоков
+    {
+        PersistentSingleLinkedList<int> shared; 
+        for (int i = 0; i < 1000; ++i) {
+            shared = shared.PushFront(i); 
+        }
+        std::vector<std::thread> threads; 
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([shared, t] {
+                for (int i = 0; i < 1000; ++i) {
+                    auto version = shared.PopFront().PushFront(t); 
+                    auto copy = version; 
+                    assert(copy.GetSize() == 1000 && copy.front() == t); 
+                }
+            }); 
+        }
+        for (auto& thread : threads) {
+            thread.join(); 
+        }
+        assert(shared.GetSize() == 1000 && shared.front() == 999); 
+    }
+
+    // Если копирование элемента бросает исключение, уже построенные узлы освобождаются
+    {
+        // Считает живые экземпляры и бросает исключение, когда разрешённые копирования кончились
+        struct Tracked {
+            Tracked(int& live, int& copies_left) : live_(&live), copies_left_(&copies_left) { ++*live_; }
+            Tracked(const Tracked& other) : live_(other.live_), copies_left_(other.copies_left_) {
+                if ((*copies_left_)-- == 0) {
+                    throw std::runtime_error("copy failed"); 
+                }
+                ++*live_; 
+            }
+            Tracked& operator=(const Tracked&) = delete; 
+            ~Tracked() { --*live_; }
+
+            int* live_; 
+            int* copies_left_; 
+        }; 
+        int live = 0; 
+        int copies_left = 2; 
+        bool thrown = false; 
+        try {
+            PersistentSingleLinkedList<Tracked> list {Tracked(live, copies_left), Tracked(live, copies_left), Tracked(live, copies_left)}; 
+        } catch (const std::runtime_error&) {
+            thrown = true; 
+        }
+        assert(thrown && live == 0); 
+    }
+
+    std::cout << "####Persistent list is OK" << std::endl;
+}
+
+void MyTest_Index() {
+    using List = IndexLinkedList<std::string>; 
+
+    // Интерфейс SingleLinkedList
+    {
+        List list{"b"s, "d"s}; 
+        list.PushFront("a"s); 
+        auto it = list.InsertAfter(++list.begin(), "c"s); 
+        assert(*it == "c"s && list.GetSize() == 4); 
+        assert((list == List{"a"s, "b"s, "c"s, "d"s})); 
+        assert(list.EmplaceFront(2, 'z') == "zz"s && list.front() == "zz"s); 
+        list.PopFront(); 
+
+        auto next = list.EraseAfter(list.begin()); 
+        assert(*next == "c"s && (list == List{"a"s, "c"s, "d"s})); 
+        assert(list.EraseAfter(++(++list.begin())) == list.end()); 
+
+        List copy = list; 
+        assert(copy == list && !(copy < list)); 
+        copy.PushFront("0"s); 
+        assert(copy != list && copy < list); 
+        List moved = std::move(copy); 
+        assert(copy.IsEmpty() && moved.GetSize() == 4); 
+        swap(moved, list); 
+        assert(list.GetSize() == 4 && moved.GetSize() == 3); 
+        list.Clear(); 
+        assert(list.IsEmpty() && list.begin() == list.end()); 
+    }
+
+    // Рост хранилища не инвалидирует итераторы; места удалённых узлов занимают новые
+    {
+        IndexLinkedList<std::string> list; 
+        auto first = list.InsertAfter(list.before_begin(), std::string(40, 'x')); 
+        auto last = first; 
+        for (int i = 0; i < 1000; ++i) {
+            last = list.InsertAfter(last, std::to_string(i)); 
+        }
+        assert(*first == std::string(40, 'x') && *last == "999"s && list.GetSize() == 1001); 
+        // Аргумент ссылается на элемент этого же списка
+        list.InsertAfter(last, *first); 
+        assert(*std::next(last) == std::string(40, 'x')); 
+
+        const size_t capacity = list.GetCapacity(); 
+        for (int i = 0; i < 500; ++i) {
+            list.EraseAfter(first); 
+        }
+        for (int i = 0; i < 500; ++i) {
+            list.PushFront("new"s); 
+        }
+        assert(list.GetCapacity() == capacity && list.GetSize() == 1002); 
+        assert(std::count(list.begin(), list.end(), "new"s) == 500); 
+    }
+
+    // Исключение при создании значения оставляет список прежним
+    {
+        struct Throwing {
+            explicit Throwing(int value) {
+                if (value < 0) {
+                    throw std::invalid_argument("negative"); 
+                }
+            }
+        }; 
+        IndexLinkedList<Throwing> list; 
+        list.EmplaceFront(1); 
+        try {
+            list.EmplaceFront(-1); 
+            assert(false); 
+        } catch (const std::invalid_argument&) {
+        }
+        assert(list.GetSize() == 1 && std::next(list.begin()) == list.end()); 
+    }
+
+    // Узел int — 8 байт вместо 16 у SingleLinkedList
+    {
+        IndexLinkedList<int> list; 
+        list.Reserve(1000); 
+        const size_t capacity = list.GetCapacity(); 
+        for (int i = 0; i < 1000; ++i) {
+            list.PushFront(i); 
+        }
+        assert(list.GetCapacity() == capacity); 
+        const auto* first = &list.front(); 
+        assert(reinterpret_cast<const char*>(&*std::next(list.begin())) - reinterpret_cast<const char*>(first) == -8); 
+    }
+
+    std::cout << "####Index list is OK" << std::endl;
+}
+
+void MyTest_Reclaim() {
+    // Копирующее присваивание переиспользует узлы
+    {
+        using CountedList = SingleLinkedList<int, std::allocator<int>, CountingListStats>; 
+        CountedList list {1, 2, 3}; 
+        const int* first = &list.front(); 
+        const CountedList same_size {4, 5, 6}; 
+        list = same_size; 
+        assert(list == same_size && &list.front() == first && list.back() == 6); 
+        assert(list.GetStats().node_allocations == 3 && list.GetStats().node_deallocations == 0); 
+
+        const CountedList longer {7, 8, 9, 10, 11}; 
+        list = longer; 
+        assert(list == longer && &list.front() == first && list.GetSize() == 5 && list.back() == 11); 
+        list.PushBack(12); 
+        assert(list.back() == 12 && list.GetSize() == 6); 
+
+        const CountedList shorter {13}; 
+        list = shorter; 
+        assert(list == shorter && &list.front() == first && list.back() == 13); 
+        assert(list.GetStats().node_allocations == 6 && list.GetStats().node_deallocations == 5); 
+        list.PushBack(14); 
+        assert((list == CountedList{13, 14})); 
+
+        list = CountedList(); 
+        assert(list.IsEmpty() && list.begin() == list.end()); 
+        list.PushBack(15); 
+        assert(list.front() == 15 && list.back() == 15); 
+    }
+
+    // Отложенная очистка: список пуст сразу, элементы уничтожаются в фоновом потоке
+    {
+        static std::atomic<int> alive{0}; 
+        struct Counted {
+            Counted() {
+                ++alive; 
+            }
+            Counted(const Counted&) {
+                ++alive; 
+            }
+            ~Counted() {
+                --alive; 
+            }
+        }; 
+
+        ListReclaimer reclaimer; 
+        SingleLinkedList<Counted> list; 
+        for (int i = 0; i < 1000; ++i) {
+            list.EmplaceFront(); 
+        }
+        list.ClearDeferred(reclaimer); 
+        assert(list.IsEmpty() && list.begin() == list.end()); 
+        list.EmplaceBack(); 
+        assert(list.GetSize() == 1); 
+        list.ClearDeferred(reclaimer); 
+        reclaimer.Drain(); 
+        assert(alive == 0 && reclaimer.GetPending() == 0); 
+
+        SingleLinkedList<std::string> strings {"a"s, "b"s}; 
+        strings.ClearDeferred(); 
+        assert(strings.IsEmpty()); 
+        ListReclaimer::Default().Drain(); 
+    }
+
+    // С аллокатором, у которого есть состояние, очистка выполняется сразу
+    {
+        auto pool = std::make_shared<NodePoolResource>(); 
+        SingleLinkedList<std::string, PoolAllocator<std::string>> list(PoolAllocator<std::string>{pool}); 
+        list.PushBack("x"s); 
+        ListReclaimer reclaimer; 
+        list.ClearDeferred(reclaimer); 
+        assert(list.IsEmpty() && pool->GetLiveSlots() == 0 && reclaimer.GetPending() == 0); 
+    }
+
+    std::cout << "####Reclaim is OK" << std::endl;
+}
+
+void MyTest_RangeInsert() {
+    // Вставка диапазонов с известной и неизвестной длиной
+    {
+        SingleLinkedList<int> list {1, 5}; 
+        const std::vector<int> middle {2, 3, 4}; 
+        auto last = list.InsertAfter(list.begin(), middle.begin(), middle.end()); 
+        assert(*last == 4 && (list == SingleLinkedList<int>{1, 2, 3, 4, 5})); 
+        assert(list.InsertAfter(last, middle.end(), middle.end()) == last && list.GetSize() == 5); 
+
+        std::istringstream input("6 7"); 
+        last = list.InsertAfter(list.before_end(), std::istream_iterator<int>(input), std::istream_iterator<int>()); 
+        assert(*last == 7 && list.back() == 7 && list.GetSize() == 7); 
+        list.PushBack(8); 
+        list.InsertAfter(list.before_begin(), {-1, 0}); 
+        assert((list == SingleLinkedList<int>{-1, 0, 1, 2, 3, 4, 5, 6, 7, 8})); 
+
+        const SingleLinkedList<int> source {10, 20}; 
+        list.Assign(source.begin(), source.end()); 
+        assert(list == source && list.back() == 20); 
+        list.Assign(list.begin(), list.end()); 
+        assert(list == source && list.back() == 20); 
+        list.Assign({}); 
+        assert(list.IsEmpty() && list.before_end() == list.before_begin()); 
+    }
+
+    // Из нового пула узлы диапазона и копии выделяются подряд
+    {
+        using List = SingleLinkedList<long long, PoolAllocator<long long>>; 
+        const std::vector<long long> values {1, 2, 3, 4, 5, 6, 7, 8}; 
+        List list; 
+        list.InsertAfter(list.before_begin(), values.begin(), values.end()); 
+        const List copy = list; 
+        for (const List* current : std::initializer_list<const List*>{&list, &copy}) {
+            const long long* prev = nullptr; 
+            for (const long long& value : *current) {
+                assert(!prev || reinterpret_cast<const char*>(&value) - reinterpret_cast<const char*>(prev) == 16); 
+                prev = &value; 
+            }
+        }
+        assert(copy == list && list.GetAllocator().GetResource().GetLiveSlots() == 16); 
+    }
+
+    // Исключение посреди диапазона оставляет список прежним
+    {
+        struct Fragile {
+            Fragile(int v) : value(v) {}
+            Fragile(const Fragile& other) : value(other.value) {
+                if (value < 0) {
+                    throw std::invalid_argument("negative"); 
+                }
+            }
+            int value; 
+        }; 
+        std::vector<Fragile> bad; 
+        bad.reserve(4); 
+        for (int value : {1, 2, -3, 4}) {
+            bad.emplace_back(value); 
+        }
+
+        auto pool = std::make_shared<NodePoolResource>(); 
+        SingleLinkedList<Fragile, PoolAllocator<Fragile>> list(PoolAllocator<Fragile>{pool}); 
+        list.EmplaceBack(0); 
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            try {
+                if (attempt == 0) {
+                    list.InsertAfter(list.begin(), bad.begin(), bad.end()); 
+                } else {
+                    list.Assign(bad.begin(), bad.end()); 
+                }
+                assert(false); 
+            } catch (const std::invalid_argument&) {
+            }
+            assert(list.GetSize() == 1 && list.front().value == 0 && &list.back() == &list.front()); 
+            assert(pool->GetLiveSlots() == 1); 
+        }
+
+        SingleLinkedList<Fragile> plain; 
+        try {
+            plain.Assign(bad.begin(), bad.end()); 
+            assert(false); 
+        } catch (const std::invalid_argument&) {
+        }
+        assert(plain.IsEmpty()); 
+    }
+
+    // Копирование считает аллокации как раньше: по одной на узел
+    {
+        using CountedList = SingleLinkedList<int, std::allocator<int>, CountingListStats>; 
+        const CountedList source {1, 2, 3}; 
+        const CountedList copy = source; 
+        assert(copy == source && copy.GetStats().node_allocations == 3); 
+        SmallSingleLinkedList<int, 4> small; 
+        const std::vector<int> values {1, 2, 3, 4, 5}; 
+        small.Assign(values.begin(), values.end()); 
+        assert(small.GetSize() == 5 && small.IsInline(small.begin()) && !small.IsInline(small.before_end())); 
+    }
+
+    std::cout << "####Range insert is OK" << std::endl;
+}
+
+void MyTest_Prefetch() {
+    SingleLinkedList<int> list; 
+    for (int i = 0; i < 100; ++i) {
+        list.PushBack(i % 10); 
+    }
+    const auto& const_list = list; 
+
+    // Обход с предвыборкой видит те же элементы, что и обычный
+    {
+        std::vector<int> plain(list.begin(), list.end()); 
+        std::vector<int> prefetched; 
+        for (int& value : list.WithPrefetch()) {
+            prefetched.push_back(value); 
+            value += 100; 
+        }
+        assert(prefetched == plain && list.front() == 100); 
+        for (int& value : list.WithPrefetch()) {
+            value -= 100; 
+        }
+        auto range = const_list.WithPrefetch(); 
+        assert(std::equal(range.begin(), range.end(), plain.begin(), plain.end())); 
+
+        // Итераторы разных политик сравниваются и преобразуются друг в друга
+        SingleLinkedList<int>::PrefetchingIterator it = list.WithPrefetch().begin(); 
+        assert(it == list.begin() && ++it != list.begin()); 
+        SingleLinkedList<int>::ConstIterator plain_it(it); 
+        SingleLinkedList<int>::PrefetchingConstIterator const_it = it; 
+        assert(plain_it == it && const_it == it && *plain_it == 1); 
+        list.InsertAfter(SingleLinkedList<int>::ConstIterator(it), 42); 
+        assert(*std::next(list.begin(), 2) == 42); 
+        list.EraseAfter(SingleLinkedList<int>::ConstIterator(it)); 
+
+        SingleLinkedList<int> empty; 
+        assert(empty.WithPrefetch().begin() == empty.WithPrefetch().end()); 
+    }
+
+    // ForEach, Find, Count, Accumulate
+    {
+        long long sum = 0; 
+        const_list.ForEach([&sum](const int& value) { sum += value; }); 
+        assert(sum == 450); 
+        list.ForEach([](int& value) { value *= 2; }); 
+        assert(list.Accumulate(0) == 900 && list.Accumulate(1LL, [](long long acc, int v) { return acc + v * v; }) == 1 + 4 * 2850); 
+        assert(list.Count(18) == 10 && list.Count(5) == 0); 
+
+        auto found = list.Find(6); 
+        assert(found != list.end() && *found == 6 && std::next(found) != list.end() && *std::next(found) == 8); 
+        *found = -6; 
+        assert(const_list.Find(-6) == found && const_list.Find(7) == const_list.end()); 
+
+        const SingleLinkedList<std::string> words {"a"s, "b"s, "b"s}; 
+        assert(words.Count("b"s) == 2 && words.Accumulate(""s) == "abb"s && words.Find("c"s) == words.end()); 
+    }
+
+    std::cout << "####Prefetch is OK" << std::endl;
+}
+
+void MyTest_Parallel() {
+    WorkStealingPool pool(4); 
+    WorkStealingPool single(1); 
+    assert(pool.GetThreadCount() == 4 && single.GetThreadCount() == 1); 
+
+    // Пул: каждая задача выполняется ровно один раз, вложенные вызовы не блокируются, исключение доходит до вызывающего
+    {
+        std::vector<std::atomic<int>> hits(1000); 
+        pool.ParallelFor(hits.size(), [&hits](size_t i) { ++hits[i]; }); 
+        assert(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int>& h) { return h == 1; })); 
+
+        std::atomic<size_t> inner{0}; 
+        pool.ParallelFor(8, [&](size_t) {
+            pool.ParallelFor(8, [&inner](size_t) { ++inner; }); 
+        }); 
+        assert(inner == 64); 
+
+        bool thrown = false; 
+        try {
+            pool.ParallelFor(100, [](size_t i) {
+                if (i == 42) {
+                    throw std::runtime_error("task"); 
+                }
+            }); 
+        } catch (const std::runtime_error&) {
+            thrown = true; 
+        }
+        assert(thrown); 
+        size_t order = 0; 
+        single.ParallelFor(5, [&order](size_t i) { assert(i == order); ++order; }); 
+        assert(order == 5); 
+    }
+
+    // Результаты совпадают с последовательными при любом числе потоков
+    SingleLinkedList<int> list; 
+    for (int i = 0; i < 100000; ++i) {
+        list.PushBack(i % 1000); 
+    }
+    const long long expected_sum = 100LL * 999 * 1000 / 2; 
+    for (WorkStealingPool* p : {&pool, &single}) {
+        assert(ParallelTransformReduce(list, 0LL, std::plus<>{}, [](int v) { return static_cast<long long>(v); }, *p) == expected_sum); 
+        assert(ParallelCountIf(list, [](int v) { return v < 10; }, *p) == 1000); 
+        std::atomic<long long> sum{0}; 
+        ParallelForEach(list, [&sum](int v) { sum += v; }, *p); 
+        assert(sum == expected_sum); 
+    }
+
+    // Свёртка идёт по порядку: некоммутативная операция даёт тот же результат, что и последовательная
+    {
+        SingleLinkedList<std::string> words; 
+        std::string expected; 
+        for (int i = 0; i < 20000; ++i) {
+            words.PushBack(std::to_string(i % 10)); 
+            expected += std::to_string(i % 10); 
+        }
+        const auto concat = [](std::string lhs, const std::string& rhs) { return lhs += rhs; }; 
+        const auto same = [](const std::string& s) { return s; }; 
+        assert(ParallelTransformReduce(words, ">"s, concat, same, pool) == ">"s + expected); 
+    }
+
+    // Контрольные точки переиспользуются, пока узлы не уходят из списка
+    {
+        ListCheckpoints<SingleLinkedList<int>> checkpoints; 
+        assert(ParallelCountIf(list, checkpoints, [](int v) { return v == 0; }, pool) == 100); 
+        assert(checkpoints.IsValidFor(list) && checkpoints.GetSegmentCount() == 16); 
+        const size_t version = list.GetStructureVersion(); 
+
+        list.PushFront(0); 
+        list.InsertAfter(std::next(list.begin(), 500), 0); 
+        list.PushBack(0); 
+        assert(list.GetStructureVersion() == version && checkpoints.IsValidFor(list)); 
+        assert(ParallelCountIf(list, checkpoints, [](int v) { return v == 0; }, pool) == 103); 
+        assert(!checkpoints.Update(list, 16)); 
+
+        list.PopFront(); 
+        assert(list.GetStructureVersion() != version && !checkpoints.IsValidFor(list)); 
+        assert(checkpoints.Update(list, 16) && checkpoints.IsValidFor(list)); 
+        size_t total = 0; 
+        for (size_t i = 0; i < checkpoints.GetSegmentCount(); ++i) {
+            const auto length = static_cast<size_t>(std::distance(checkpoints.GetSegmentBegin(i), checkpoints.GetSegmentEnd(i))); 
+            assert(length >= list.GetSize() / 16 && length <= list.GetSize() / 16 + 1); 
+            total += length; 
+        }
+        assert(total == list.GetSize()); 
+
+        // Версия меняется при любом перевешивании узлов
+        const size_t before_sort = list.GetStructureVersion(); 
+        list.Sort(); 
+        SingleLinkedList<int> other {1, 2}; 
+        const size_t other_version = other.GetStructureVersion(); 
+        list.swap(other); 
+        assert(list.GetStructureVersion() > before_sort + 1 && other.GetStructureVersion() != other_version); 
+        list.swap(other); 
+        const size_t before_clear = list.GetStructureVersion(); 
+        list.Clear(); 
+        assert(list.GetStructureVersion() != before_clear); 
+        assert(ParallelCountIf(list, checkpoints, [](int) { return true; }, pool) == 0 && checkpoints.GetSegmentCount() == 0); 
+    }
+
+    // Список, построенный заново на месте уничтоженного (тот же адрес, только вставки), не принимается за прежний
+    {
+        ListCheckpoints<SingleLinkedList<int>> checkpoints; 
+        for (int round = 0; round < 3; ++round) {
+            SingleLinkedList<int> numbers; 
+            for (int i = 0; i < 100000; ++i) {
+                numbers.PushFront(round); 
+            }
+            assert(!checkpoints.IsValidFor(numbers)); 
+            const long long sum = ParallelTransformReduce(numbers, checkpoints, 0LL, std::plus<>{}, [](int v) { return static_cast<long long>(v); }, pool); 
+            assert(sum == 100000LL * round && checkpoints.IsValidFor(numbers)); 
+        }
+    }
+
+    // Исключение из функции пользователя пробрасывается, список не меняется
+    {
+        SmallSingleLinkedList<int, 4> small; 
+        for (int i = 0; i < 50000; ++i) {
+            small.PushBack(i); 
+        }
+        bool thrown = false; 
+        try {
+            ParallelForEach(small, [](int v) {
+                if (v == 40000) {
+                    throw std::runtime_error("visit"); 
+                }
+            }, pool); 
+        } catch (const std::runtime_error&) {
+            thrown = true; 
+        }
+        assert(thrown && small.GetSize() == 50000); 
+        assert(ParallelCountIf(small, [](int v) { return v % 2 == 0; }, pool) == 25000); 
+    }
+
+    std::cout << "####Parallel is OK" << std::endl;
+}
+
+void MyTest_Positional() {
+    using List = PositionalSingleLinkedList<int>; 
+
+    // Случайные вставки и удаления: индекс всё время совпадает с моделью
+    {
+        List list; 
+        std::vector<int> model; 
+        std::mt19937 rng(7); 
+        const auto check = [&] {
+            assert(list.GetSize() == model.size()); 
+            for (size_t k = 0; k < model.size(); ++k) {
+                assert(list.At(k) == model[k]); 
+            }
+            size_t position = 0; 
+            for (auto it = list.begin(); it != list.end(); ++it, ++position) {
+                assert(list.GetPosition(it) == position); 
+            }
+            assert(list.GetPosition(list.end()) == model.size()); 
+        }; 
+        for (int step = 0; step < 30000; ++step) {
+            const unsigned op = rng() % 10; 
+            if (op < 3 || model.empty()) {
+                list.PushFront(step); 
+                model.insert(model.begin(), step); 
+            } else if (op < 5) {
+                list.PushBack(step); 
+                model.push_back(step); 
+            } else if (op < 7) {
+                const size_t k = rng() % model.size(); 
+                assert(*list.InsertAfter(list.IteratorAt(k), step) == step); 
+                model.insert(model.begin() + static_cast<std::ptrdiff_t>(k) + 1, step); 
+            } else if (op < 8) {
+                list.PopFront(); 
+                model.erase(model.begin()); 
+            } else if (model.size() > 1) {
+                const size_t k = rng() % (model.size() - 1); 
+                const auto next = list.EraseAfter(list.IteratorAt(k)); 
+                model.erase(model.begin() + static_cast<std::ptrdiff_t>(k) + 1); 
+                assert(k + 1 == model.size() ? next == list.end() : *next == model[k + 1]); 
+            }
+            if (step % 3000 == 0) {
+                check(); 
+            }
+        }
+        check(); 
+        assert(list.GetBlockCount() > 1); 
+
+        for (size_t n : {size_t{0}, size_t{1}, size_t{5}, size_t{500}, model.size() - 1}) {
+            assert(*list.Advance(list.begin(), n) == model[n]); 
+            const List& const_list = list; 
+            assert(*const_list.Advance(const_list.IteratorAt(1), n - (n > 0 ? 1 : 0)) == model[std::max<size_t>(n, 1)]); 
+        }
+        assert(list.IteratorAt(model.size()) == list.end() && list.Advance(list.begin(), model.size()) == list.end()); 
+
+        bool thrown = false; 
+        try {
+            (void)list.At(model.size()); 
+        } catch (const std::out_of_range&) {
+            thrown = true; 
+        }
+        assert(thrown); 
+    }
+
+    // Итератор, полученный до деления блоков, по-прежнему годится для вставки и удаления
+    {
+        List list; 
+        for (int i = 0; i < 100; ++i) {
+            list.PushBack(i); 
+        }
+        const auto anchor = list.IteratorAt(10); 
+        const size_t blocks = list.GetBlockCount(); 
+        for (int i = 0; i < 1000; ++i) {
+            list.InsertAfter(anchor, -i); 
+        }
+        assert(list.GetBlockCount() > blocks); 
+        assert(list.At(11) == -999 && list.At(1010) == 0 && list.At(1011) == 11); 
+        list.EraseAfter(anchor); 
+        assert(list.At(11) == -998 && list.GetPosition(anchor) == 10 && list.GetSize() == 1099); 
+    }
+
+    // Копирование, перемещение, swap и Clear
+    {
+        List list {1, 2, 3, 4, 5}; 
+        List copy(list); 
+        assert(copy == list && copy.At(4) == 5); 
+        copy.PushFront(0); 
+        assert(copy != list && !(list < copy) && copy.At(0) == 0 && copy.At(5) == 5); 
+
+        const auto it = list.IteratorAt(2); 
+        list.swap(copy); 
+        // Итератор переехал вместе с узлом в другой список
+        assert(*it == 3 && copy.GetPosition(it) == 2 && list.GetPosition(list.IteratorAt(3)) == 3); 
+        copy.InsertAfter(it, 30); 
+        assert(copy.At(3) == 30 && copy.GetSize() == 6); 
+
+        List moved(std::move(copy)); 
+        assert(copy.IsEmpty() && moved.At(3) == 30 && moved.GetPosition(it) == 2); 
+        copy.PushBack(7); 
+        assert(copy.At(0) == 7 && copy.GetSize() == 1); 
+        moved = std::move(copy); 
+        assert(moved.GetSize() == 1 && moved.front() == 7); 
+
+        moved.Clear(); 
+        assert(moved.IsEmpty() && moved.GetBlockCount() == 0 && moved.begin() == moved.end()); 
+        moved.PushBack(1); 
+        moved.PushFront(0); 
+        assert(moved.At(0) == 0 && moved.At(1) == 1 && moved.back() == 1); 
+
+        SingleLinkedList<int> plain {5, 6, 7}; 
+        List adopted(std::move(plain)); 
+        assert(plain.IsEmpty() && adopted.At(2) == 7 && adopted.GetList().GetSize() == 3); 
+    }
+
+    // Индекс переживает перемещение и разрушение исходного списка; со сборкой с SLL_ENABLE_STATS
+    // здесь проверяется, что итераторы индекса не ссылаются на статистику исходного объекта
+    {
+        auto source = std::make_unique<List>(); 
+        for (int i = 0; i < 100; ++i) {
+            source->PushBack(i); 
+        }
+        List moved(std::move(*source)); 
+        source.reset(); 
+        assert(moved.At(57) == 57 && moved.GetPosition(moved.IteratorAt(99)) == 99); 
+
+        auto other = std::make_unique<List>(List{1, 2, 3}); 
+        moved.swap(*other); 
+        other.reset(); 
+        assert(moved.At(2) == 3); 
+    }
+
+    // Итераторы не ссылаются на объект, который их выдал: после перемещения или обмена и разрушения
+    // этого объекта их можно продвигать и передавать списку, где теперь лежат их узлы
+    {
+        auto source = std::make_unique<List>(); 
+        for (int i = 0; i < 1000; ++i) {
+            source->PushBack(i); 
+        }
+        auto it = source->begin(); 
+        List moved(std::move(*source)); 
+        source.reset(); 
+        for (int i = 0; i < 500; ++i) {
+            ++it; 
+        }
+        assert(*it == 500 && moved.GetPosition(it) == 500); 
+        moved.InsertAfter(it, -1); 
+        assert(moved.At(501) == -1 && moved.At(502) == 501 && moved.GetSize() == 1001); 
+
+        auto other = std::make_unique<List>(List{7, 8}); 
+        auto other_it = other->begin(); 
+        auto moved_it = moved.IteratorAt(998); 
+        moved.swap(*other); 
+        other_it++; 
+        assert(*other_it == 8 && moved.GetPosition(other_it) == 1); 
+        other.reset(); 
+        moved.EraseAfter(moved.begin()); 
+        assert(moved.GetSize() == 1 && moved.back() == 7); 
+        (void)moved_it; 
+
+        // Итератор, прошедший несколько блоков, уточняет свой блок по списку
+        List list; 
+        for (int i = 0; i < 5000; ++i) {
+            list.PushBack(i); 
+        }
+        auto walker = list.begin(); 
+        for (int i = 0; i < 3000; ++i) {
+            ++walker; 
+        }
+        list.InsertAfter(walker, -2); 
+        walker = list.EraseAfter(walker); 
+        assert(*walker == 3001 && list.GetPosition(walker) == 3001 && list.At(4999) == 4999); 
+        for (int i = 0; i < 5000; i += 250) {
+            assert(list.GetPosition(list.IteratorAt(i)) == static_cast<size_t>(i) && list.At(i) == i); 
+        }
+    }
+
+    // Если конструктор элемента бросает исключение, список и индекс не меняются
+    {
+        PositionalSingleLinkedList<std::string> words {"a"s, "b"s, "c"s}; 
+        bool thrown = false; 
+        try {
+            words.EmplaceAfter(words.IteratorAt(1), std::string::npos, 'x'); 
+        } catch (const std::length_error&) {
+            thrown = true; 
+        }
+        assert(thrown && words.GetSize() == 3 && words.At(2) == "c"s); 
+    }
+
+    std::cout << "####Positional list is OK" << std::endl;
+}
+
+void MyTest_Sorted() {
+    // Случайные операции сверяются с std::multiset
+    {
+        SortedSingleLinkedList<int> list; 
+        std::multiset<int> model; 
+        std::mt19937 rng(3); 
+        for (int step = 0; step < 50000; ++step) {
+            const int value = static_cast<int>(rng() % 2000); 
+            const unsigned op = rng() % 10; 
+            if (op < 5) {
+                assert(*list.Insert(value) == value); 
+                model.insert(value); 
+            } else if (op < 7) {
+                assert(list.Erase(value) == model.erase(value)); 
+            } else if (op < 8) {
+                const auto it = list.LowerBound(value); 
+                const auto model_it = model.lower_bound(value); 
+                assert((it == list.end()) == (model_it == model.end())); 
+                if (it != list.end()) {
+                    const auto next = list.Erase(it); 
+                    const auto model_next = model.erase(model_it); 
+                    assert(next == list.end() ? model_next == model.end() : *next == *model_next); 
+                }
+            } else {
+                assert(list.Contains(value) == (model.count(value) > 0) && list.Count(value) == model.count(value)); 
+                const auto upper = list.UpperBound(value); 
+                const auto model_upper = model.upper_bound(value); 
+                assert(upper == list.end() ? model_upper == model.end() : *upper == *model_upper); 
+                const auto found = list.Find(value); 
+                assert(found == list.end() ? !model.count(value) : *found == value); 
+            }
+        }
+        assert(list.GetSize() == model.size() && std::equal(list.begin(), list.end(), model.begin(), model.end())); 
+        assert(list.front() == *model.begin()); 
+
+        // Удаление по ссылке на элемент самого списка
+        const int smallest = list.front(); 
+        assert(list.Erase(list.front()) == model.count(smallest) && !list.Contains(smallest)); 
+    }
+
+    // Равные элементы встают после имеющихся, свой порядок сравнения
+    {
+        struct ByLength {
+            bool operator()(const std::string& lhs, const std::string& rhs) const {
+                return lhs.size() < rhs.size(); 
+            }
+        }; 
+        SortedSingleLinkedList<std::string, ByLength> words {"ccc"s, "a"s, "bb"s, "b"s, "dd"s}; 
+        const std::vector<std::string> expected {"a"s, "b"s, "bb"s, "dd"s, "ccc"s}; 
+        assert(std::equal(words.begin(), words.end(), expected.begin(), expected.end())); 
+        assert(words.Count("zz"s) == 2 && *words.Find("zz"s) == "bb"s && *words.UpperBound("z"s) == "bb"s); 
+
+        SortedSingleLinkedList<int, std::greater<>> descending {1, 5, 3}; 
+        assert(descending.front() == 5 && *std::next(descending.begin(), 2) == 1 && descending.LowerBound(4) != descending.end() && *descending.LowerBound(4) == 3); 
+    }
+
+    // Копирование, перемещение, сравнение
+    {
+        SortedSingleLinkedList<int> list {3, 1, 2}; 
+        SortedSingleLinkedList<int> copy(list); 
+        assert(copy == list && copy.GetSize() == 3); 
+        copy.Insert(4); 
+        assert(list < copy && copy > list && list != copy && list <= copy); 
+        const auto it = copy.Find(4); 
+        SortedSingleLinkedList<int> moved(std::move(copy)); 
+        assert(copy.IsEmpty() && copy.begin() == copy.end() && *it == 4 && moved.Find(4) == it); 
+        copy = moved; 
+        assert(copy == moved); 
+        copy.Insert(0); 
+        moved.swap(copy); 
+        assert(moved.front() == 0 && copy.front() == 1); 
+        moved.Clear(); 
+        assert(moved.IsEmpty() && moved.Find(0) == moved.end()); 
+        moved.Insert(7); 
+        assert(moved.front() == 7 && moved.GetSize() == 1); 
+    }
+
+    // Исключение в конструкторе элемента не меняет список
+    {
+        SortedSingleLinkedList<std::string> words {"a"s, "c"s}; 
+        bool thrown = false; 
+        try {
+            words.Emplace(std::string::npos, 'x'); 
+        } catch (const std::length_error&) {
+            thrown = true; 
+        }
+        assert(thrown && words.GetSize() == 2 && words.Contains("c"s)); 
+    }
+
+    // Поиск и удаление noexcept, только если сравнение не бросает; брошенное сравнением исключение доходит до вызывающего
+    {
+        struct NothrowLess {
+            bool operator()(int lhs, int rhs) const noexcept {
+                return lhs < rhs; 
+            }
+        }; 
+        static_assert(noexcept(std::declval<const SortedSingleLinkedList<int, NothrowLess>&>().Find(0))); 
+        static_assert(noexcept(std::declval<SortedSingleLinkedList<int, NothrowLess>&>().Erase(0))); 
+
+        struct ThrowingLess {
+            const bool* armed; 
+            bool operator()(int lhs, int rhs) const {
+                if (*armed) {
+                    throw std::runtime_error("compare"); 
+                }
+                return lhs < rhs; 
+            }
+        }; 
+        using List = SortedSingleLinkedList<int, ThrowingLess>; 
+        static_assert(!noexcept(std::declval<const List&>().Count(0))); 
+        static_assert(!noexcept(std::declval<List&>().Erase(std::declval<List&>().begin()))); 
+
+        bool armed = false; 
+        List list(ThrowingLess{&armed}); 
+        for (int i = 0; i < 100; ++i) {
+            list.Insert(i % 10); 
+        }
+        armed = true; 
+        int thrown = 0; 
+        for (auto call : {0, 1, 2, 3, 4}) {
+            try {
+                switch (call) {
+                    case 0: (void)list.Find(5); break; 
+                    case 1: (void)list.Count(5); break; 
+                    case 2: list.Erase(5); break; 
+                    case 3: list.Erase(list.Find(5)); break; 
+                    default: list.Insert(5); break; 
+                }
+            } catch (const std::runtime_error&) {
+                ++thrown; 
+            }
+        }
+        armed = false; 
+        assert(thrown == 5 && list.GetSize() == 100 && list.Count(5) == 10); 
+        assert(std::is_sorted(list.begin(), list.end())); 
+    }
+
+    std::cout << "####Sorted list is OK" << std::endl;
+}
+
+void MyTest_Hashed() {
+    // Случайные перевязки сверяются с вектором пар; после каждой индекс должен указывать на верных предшественников
+    {
+        // Плохой хеш собирает ключи в длинные цепочки и проверяет сдвиг записей при удалении
+        struct CoarseHash {
+            size_t operator()(int key) const {
+                return static_cast<size_t>(key / 16); 
+            }
+        }; 
+        HashedSingleLinkedList<int, int, CoarseHash> list; 
+        std::vector<std::pair<int, int>> model; 
+        const auto model_find = [&model](int key) {
+            return std::find_if(model.begin(), model.end(), [key](const auto& item) { return item.first == key; }); 
+        }; 
+        const auto check = [&] {
+            assert(list.GetSize() == model.size()); 
+            assert(std::equal(list.begin(), list.end(), model.begin(), model.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.first == rhs.first && lhs.second == rhs.second; 
+            })); 
+            auto before = list.before_begin(); 
+            for (const auto& [key, value] : model) {
+                assert(list.FindBefore(key) == before && list.Find(key)->second == value); 
+                ++before; 
+            }
+            assert(model.empty() || (list.back().first == model.back().first && list.before_end() == list.Find(model.back().first))); 
+        }; 
+        std::mt19937 rng(5); 
+        for (int step = 0; step < 20000; ++step) {
+            const int key = static_cast<int>(rng() % 500); 
+            const int value = static_cast<int>(rng()); 
+            const bool present = model_find(key) != model.end(); 
+            assert(list.Contains(key) == present); 
+            switch (rng() % 8) {
+            case 0: {
+                const bool inserted = list.PushFront({key, value}).second; 
+                assert(inserted == !present); 
+                if (!present) {
+                    model.insert(model.begin(), {key, value}); 
+                }
+                break; 
+            }
+            case 1:
+                assert(list.PushBack({key, value}).second == !present); 
+                if (!present) {
+                    model.push_back({key, value}); 
+                }
+                break; 
+            case 2:
+                // Вставка после случайного элемента
+                if (!model.empty() && !present) {
+                    const size_t index = rng() % model.size(); 
+                    const auto [it, inserted] = list.TryEmplaceAfter(list.Find(model[index].first), key, value); 
+                    assert(inserted && it->first == key && it->second == value); 
+                    model.insert(model.begin() + static_cast<std::ptrdiff_t>(index) + 1, {key, value}); 
+                }
+                break; 
+            case 3:
+                assert(list.EraseByKey(key) == present); 
+                if (present) {
+                    model.erase(model_find(key)); 
+                }
+                break; 
+            case 4:
+                // Удаление элемента после найденного
+                if (present && std::next(model_find(key)) != model.end()) {
+                    const auto next = list.EraseAfter(list.Find(key)); 
+                    const auto erased = model.erase(std::next(model_find(key))); 
+                    assert(erased == model.end() ? next == list.end() : next->first == erased->first); 
+                }
+                break; 
+            case 5:
+                assert(list.MoveToFront(key) == present); 
+                if (present) {
+                    std::rotate(model.begin(), model_find(key), std::next(model_find(key))); 
+                }
+                break; 
+            case 6:
+                if (model.empty()) {
+                    break; 
+                }
+                if (rng() % 2) {
+                    list.PopFront(); 
+                    model.erase(model.begin()); 
+                } else {
+                    list.PopBack(); 
+                    model.pop_back(); 
+                }
+                break; 
+            default:
+                if (present) {
+                    list.Find(key)->second = value; 
+                    model_find(key)->second = value; 
+                }
+                break; 
+            }
+            if (step % 97 == 0) {
+                check(); 
+            }
+        }
+        check(); 
+        assert(list.GetBucketCount() >= list.GetSize() * 4 / 3); 
+    }
+
+    // Копирование, перемещение, обмен: запись первого элемента ссылается на before_begin() своего объекта
+    {
+        HashedSingleLinkedList<std::string, int> list {{"a"s, 1}, {"b"s, 2}, {"c"s, 3}}; 
+        HashedSingleLinkedList<std::string, int> copy(list); 
+        assert(copy.FindBefore("a"s) == copy.before_begin() && copy.Find("c"s)->second == 3); 
+        copy.EraseByKey("a"s); 
+        assert(list.GetSize() == 3 && copy.front().first == "b"s && copy.FindBefore("b"s) == copy.before_begin()); 
+
+        HashedSingleLinkedList<std::string, int> moved(std::move(list)); 
+        assert(list.IsEmpty() && !list.Contains("a"s) && moved.FindBefore("a"s) == moved.before_begin()); 
+        moved.PopFront(); 
+        assert(moved.front().first == "b"s && moved.FindBefore("b"s) == moved.before_begin()); 
+
+        moved.swap(copy); 
+        assert(copy.FindBefore("b"s) == copy.before_begin() && moved.FindBefore("b"s) == moved.before_begin()); 
+        assert(moved.MoveToFront("c"s) && moved.front().first == "c"s && moved.back().first == "b"s); 
+
+        list = moved; 
+        assert(list.FindBefore("c"s) == list.before_begin() && list.FindBefore("b"s) == list.begin()); 
+        list.Clear(); 
+        assert(list.IsEmpty() && !list.Contains("c"s)); 
+        assert(list.PushFront({"d"s, 4}).second && list.FindBefore("d"s) == list.before_begin()); 
+    }
+
+    // Перемещение с аллокатором, который не распространяется при обмене: узлы уходят вместе с аллокатором,
+    // а при присваивании в объект с другим ресурсом значения перемещаются в его узлы
+    {
+        using PmrMap = HashedSingleLinkedList<int, std::string, std::hash<int>, std::equal_to<int>,
+                                              std::pmr::polymorphic_allocator<std::pair<const int, std::string>>>; 
+        NodePoolResource pool_1; 
+        NodePoolResource pool_2; 
+        PmrMap one ({{1, "a"s}, {2, "b"s}, {3, "c"s}}, &pool_1); 
+        PmrMap moved(std::move(one)); 
+        assert(one.IsEmpty() && one.GetBucketCount() == 0 && !one.Contains(1)); 
+        assert(moved.GetList().GetAllocator().resource() == &pool_1 && pool_1.GetLiveSlots() == 3); 
+        assert(moved.FindBefore(1) == moved.before_begin() && moved.Find(3)->second == "c"s); 
+        assert(one.PushBack({4, "d"s}).second && one.FindBefore(4) == one.before_begin()); 
+
+        PmrMap other (&pool_2); 
+        other.PushBack({9, "z"s}); 
+        other = std::move(moved); 
+        assert(moved.IsEmpty() && !moved.Contains(2) && pool_1.GetLiveSlots() == 1); 
+        assert(other.GetSize() == 3 && pool_2.GetLiveSlots() == 3 && !other.Contains(9)); 
+        assert(other.FindBefore(1) == other.before_begin() && other.Find(2)->second == "b"s); 
+
+        PmrMap same (&pool_1); 
+        same = std::move(one); 
+        assert(one.IsEmpty() && same.Find(4)->second == "d"s && pool_1.GetLiveSlots() == 1); 
+    }
+
+    // Исключение в конструкторе значения не меняет ни список, ни индекс
+    {
+        HashedSingleLinkedList<int, std::string> list {{1, "a"s}, {2, "b"s}}; 
+        bool thrown = false; 
+        try {
+            list.TryEmplaceAfter(list.before_begin(), 3, std::string::npos, 'x'); 
+        } catch (const std::length_error&) {
+            thrown = true; 
+        }
+        assert(thrown && list.GetSize() == 2 && !list.Contains(3) && list.FindBefore(1) == list.before_begin()); 
+        // Ключ уже есть: значение не перезаписывается
+        const auto [it, inserted] = list.TryEmplaceAfter(list.before_begin(), 2, "z"); 
+        assert(!inserted && it->second == "b"s && list.GetSize() == 2); 
+    }
+
+    std::cout << "####Hashed list is OK" << std::endl;
+}
+
+void MyTest_Lru() {
+    // Случайные Get/Put/Erase сверяются с вектором, упорядоченным от свежих к старым
+    {
+        LruCache<int, int> cache(50); 
+        std::vector<std::pair<int, int>> model; 
+        LruCacheStats expected; 
+        std::mt19937 rng(7); 
+        for (int step = 0; step < 50000; ++step) {
+            const int key = static_cast<int>(rng() % 120); 
+            const auto found = std::find_if(model.begin(), model.end(), [key](const auto& item) { return item.first == key; }); 
+            const unsigned op = rng() % 10; 
+            if (op < 5) {
+                const int* value = cache.Get(key); 
+                assert((value != nullptr) == (found != model.end())); 
+                if (value) {
+                    assert(*value == found->second); 
+                    std::rotate(model.begin(), found, std::next(found)); 
+                    ++expected.hits; 
+                } else {
+                    ++expected.misses; 
+                }
+            } else if (op < 9) {
+                const int value = static_cast<int>(rng()); 
+                assert(cache.Put(key, value) == value); 
+                if (found != model.end()) {
+                    model.erase(found); 
+                } else if (model.size() == 50) {
+                    model.pop_back(); 
+                    ++expected.evictions; 
+                }
+                model.insert(model.begin(), {key, value}); 
+            } else {
+                assert(cache.Erase(key) == (found != model.end())); 
+                if (found != model.end()) {
+                    model.erase(found); 
+                }
+            }
+            if (step % 101 == 0) {
+                assert(cache.GetSize() == model.size() && cache.GetSize() <= cache.GetCapacity()); 
+                assert(std::equal(cache.begin(), cache.end(), model.begin(), model.end(), [](const auto& lhs, const auto& rhs) {
+                    return lhs.first == rhs.first && lhs.second == rhs.second; 
+                })); 
+            }
+        }
+        const LruCacheStats stats = cache.GetStats(); 
+        assert(stats.hits == expected.hits && stats.misses == expected.misses && stats.evictions == expected.evictions); 
+        assert(stats.hits > 0 && stats.misses > 0 && stats.evictions > 0); 
+        cache.ResetStats(); 
+        assert(cache.GetStats().hits == 0 && cache.GetStats().evictions == 0); 
+    }
+
+    // Peek не меняет порядок; вытесняется самый старый; ключ-строка
+    {
+        LruCache<std::string, int> cache(2); 
+        cache.Put("a"s, 1); 
+        cache.Put("b"s, 2); 
+        assert(*cache.Peek("a"s) == 1 && cache.begin()->first == "b"s && cache.GetStats().hits == 0); 
+        assert(*cache.Get("a"s) == 1 && cache.begin()->first == "a"s); 
+        cache.Put("c"s, 3); 
+        assert(!cache.Contains("b"s) && cache.Contains("a"s) && cache.Contains("c"s) && cache.GetStats().evictions == 1); 
+        // Перезапись существующего ключа ничего не вытесняет
+        cache.Put("a"s, 10) += 1; 
+        assert(*cache.Peek("a"s) == 11 && cache.GetSize() == 2 && cache.GetStats().evictions == 1); 
+
+        LruCache<std::string, int> moved(std::move(cache)); 
+        assert(moved.GetSize() == 2 && *moved.Get("c"s) == 3); 
+        moved.Clear(); 
+        assert(moved.IsEmpty() && moved.Get("c"s) == nullptr); 
+
+        LruCache<int, int> single(1); 
+        single.Put(1, 1); 
+        single.Put(2, 2); 
+        assert(single.GetSize() == 1 && single.Get(1) == nullptr && *single.Get(2) == 2); 
+
+        bool thrown = false; 
+        try {
+            LruCache<int, int> empty(0); 
+        } catch (const std::invalid_argument&) {
+            thrown = true; 
+        }
+        assert(thrown); 
+    }
+
+    // Заполненный кеш переиспользует узлы вытесненных элементов: пул не берёт новых slab'ов
+    {
+        LruCache<int, long long> cache(10000); 
+        for (int key = 0; key < 20000; ++key) {
+            cache.Put(key, key); 
+        }
+        const size_t slabs = cache.GetNodePool().GetSlabCount(); 
+        std::mt19937 rng(11); 
+        for (int step = 0; step < 200000; ++step) {
+            const int key = static_cast<int>(rng() % 30000); 
+            if (!cache.Get(key)) {
+                cache.Put(key, key); 
+            }
+        }
+        assert(cache.GetNodePool().GetSlabCount() == slabs && cache.GetNodePool().GetLiveSlots() == cache.GetSize()); 
+        assert(cache.GetSize() == 10000 && cache.GetStats().evictions > 10000); 
+    }
+
+    std::cout << "####LRU cache is OK" << std::endl;
+}
+
+void MyTest_ThreadCache() {
+    using CachedList = SingleLinkedList<int, ThreadCachingAllocator<int>>; 
+    ThreadNodeCache::Trim(); 
+
+    // Освобождённые узлы переиспользуются: в установившемся режиме нет обращений к operator new
+    {
+        const ThreadNodeCache::Stats before = ThreadNodeCache::GetStats(); 
+        CachedList list; 
+        for (int i = 0; i < 100; ++i) {
+            list.PushFront(i); 
+        }
+        assert(ThreadNodeCache::GetStats().misses == before.misses + 100); 
+        list.Clear(); 
+        assert(ThreadNodeCache::GetStats().cached == 100); 
+
+        const ThreadNodeCache::Stats warm = ThreadNodeCache::GetStats(); 
+        list.PushBack(-1); 
+        for (int round = 0; round < 1000; ++round) {
+            list.PushFront(round); 
+            list.InsertAfter(list.begin(), round); 
+            list.PushBack(round); 
+            list.PopFront(); 
+            list.EraseAfter(list.begin()); 
+            list.PopFront(); 
+        }
+        const ThreadNodeCache::Stats after = ThreadNodeCache::GetStats(); 
+        assert(after.misses == warm.misses && after.hits == warm.hits + 3001); 
+        assert(list.GetSize() == 1 && list.front() == 999 && after.cached == 99); 
+        list.Clear(); 
+
+        // Узел другого размера — другой класс кеша
+        SingleLinkedList<std::string, ThreadCachingAllocator<std::string>> words; 
+        words.PushFront("long enough not to fit into the small string buffer"s); 
+        assert(ThreadNodeCache::GetStats().misses == after.misses + 1); 
+    }
+
+    // Предел и Trim
+    {
+        ThreadNodeCache::Trim(); 
+        ThreadNodeCache::SetLimit(10); 
+        assert(ThreadNodeCache::GetLimit() == 10); 
+        {
+            CachedList list; 
+            for (int i = 0; i < 100; ++i) {
+                list.PushFront(i); 
+            }
+        }
+        assert(ThreadNodeCache::GetStats().cached == 10); 
+        ThreadNodeCache::SetLimit(4); 
+        assert(ThreadNodeCache::GetStats().cached == 4); 
+        ThreadNodeCache::Trim(); 
+        assert(ThreadNodeCache::GetStats().cached == 0); 
+        ThreadNodeCache::SetLimit(ThreadNodeCache::kDefaultLimit); 
+    }
+
+    // Узлы, освобождённые в другом потоке, попадают в его кеш и освобождаются при его завершении
+    {
+        CachedList list {1, 2, 3}; 
+        CachedList other {4}; 
+        other.SpliceAfter(other.before_begin(), list); 
+        assert(list.IsEmpty() && (other == CachedList {1, 2, 3, 4})); 
+        const size_t cached = ThreadNodeCache::GetStats().cached; 
+        std::thread([moved = std::move(other)]() mutable {
+            moved.Clear(); 
+            assert(ThreadNodeCache::GetStats().cached == 4); 
+        }).join(); 
+        assert(ThreadNodeCache::GetStats().cached == cached); 
+    }
+
+    std::cout << "####Thread node cache is OK" << std::endl;
+}
+
+void MyTest_FineGrained() {
+    // Однопоточная семантика курсоров
+    {
+        FineGrainedSingleLinkedList<std::string> list; 
+        assert(list.IsEmpty() && !list.PopFront() && !list.Contains("a"s)); 
+        list.PushFront("c"s); 
+        list.EmplaceFront(1, 'a'); 
+        {
+            auto cursor = list.LockFirst("a"s); 
+            assert(cursor && !cursor.IsBeforeBegin() && *cursor == "a"s && cursor->size() == 1); 
+            assert(cursor.InsertAfter("b"s) == "b"s); 
+            assert(cursor.Next() && *cursor == "b"s && cursor.Next() && *cursor == "c"s); 
+            assert(!cursor.HasNext() && !cursor.Next() && *cursor == "c"s && !cursor.EraseAfter()); 
+            cursor.EmplaceAfter(2, 'd'); 
+        }
+        assert(list.GetSize() == 4 && list.Contains("dd"s) && !list.Contains("d"s)); 
+        assert(!list.LockFirst("zz"s)); 
+        {
+            auto cursor = list.LockBeforeBegin(); 
+            assert(cursor.IsBeforeBegin() && cursor.HasNext()); 
+            assert(*cursor.EraseAfter() == "a"s && *cursor.EraseAfter() == "b"s); 
+            auto moved = std::move(cursor); 
+            assert(!cursor && moved.IsBeforeBegin()); 
+        }
+        assert(list.Erase("dd"s) && !list.Erase("dd"s) && list.GetSize() == 1); 
+        assert(*list.PopFront() == "c"s && list.IsEmpty() && list.GetSize() == 0); 
+    }
+
+    // Потоки вставляют и удаляют каждый после своего якоря, пока читатели проверяют Contains без блокировок.
+    // У каждого значения один пишущий поток, поэтому Contains обязан сразу видеть результат его операций:
+    // вставленное — есть, удалённое — нет. Постоянные значения видны всегда, никогда не вставленные — никогда
+    {
+        constexpr int kWriters = 4; 
+        constexpr int kReaders = 2; 
+        constexpr int kOpsPerWriter = 4000; 
+        constexpr int kPermanent = 200; 
+        constexpr int kPermanentBase = 1000000; 
+        FineGrainedSingleLinkedList<int> list; 
+        // Постоянные значения в конце списка, перед ними якоря писателей: -1, -2, ...
+        for (int i = 0; i < kPermanent; ++i) {
+            list.PushFront(kPermanentBase + i); 
+        }
+        for (int t = kWriters; t >= 1; --t) {
+            list.PushFront(-t); 
+        }
+        std::vector<std::vector<int>> live(kWriters); 
+        std::atomic<int> writers_done {0}; 
+        std::vector<std::thread> threads; 
+        for (int t = 0; t < kWriters; ++t) {
+            threads.emplace_back([&list, &live, &writers_done, t] {
+                std::mt19937 rng(static_cast<unsigned>(t)); 
+                std::vector<int>& mine = live[t]; 
+                for (int i = 0; i < kOpsPerWriter; ++i) {
+                    auto cursor = list.LockFirst(-(t + 1)); 
+                    assert(cursor); 
+                    if (mine.empty() || rng() % 3 != 0) {
+                        const int value = t * kOpsPerWriter + i; 
+                        cursor.InsertAfter(value); 
+                        cursor.Release(); 
+                        mine.push_back(value); 
+                        assert(list.Contains(value)); 
+                    } else {
+                        const auto erased = cursor.EraseAfter(); 
+                        cursor.Release(); 
+                        assert(erased && *erased == mine.back()); 
+                        mine.pop_back(); 
+                        assert(!list.Contains(*erased)); 
+                    }
+                }
+                ++writers_done; 
+            }); 
+        }
+        for (int r = 0; r < kReaders; ++r) {
+            threads.emplace_back([&list, &writers_done, r] {
+                std::mt19937 rng(static_cast<unsigned>(100 + r)); 
+                while (writers_done.load() < kWriters) {
+                    assert(list.Contains(kPermanentBase + static_cast<int>(rng() % kPermanent))); 
+                    assert(!list.Contains(-1 - static_cast<int>(rng() % 1000) - kWriters)); 
+                }
+            }); 
+        }
+        for (auto& thread : threads) {
+            thread.join(); 
+        }
+
+        // Итог: за каждым якорем — значения его потока от последнего вставленного к первому
+        std::vector<int> expected; 
+        for (int t = 0; t < kWriters; ++t) {
+            expected.push_back(-(t + 1)); 
+            expected.insert(expected.end(), live[t].rbegin(), live[t].rend()); 
+        }
+        for (int i = kPermanent - 1; i >= 0; --i) {
+            expected.push_back(kPermanentBase + i); 
+        }
+        std::vector<int> actual; 
+        for (auto cursor = list.LockBeforeBegin(); cursor.Next();) {
+            actual.push_back(*cursor); 
+        }
+        assert(actual == expected && list.GetSize() == expected.size()); 
+    }
+
+    std::cout << "####Fine-grained list is OK" << std::endl;
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "work_stealing_pool.h"
+
+// Параллельные алгоритмы только для чтения над SingleLinkedList и SmallSingleLinkedList.
+// Список делится на отрезки по контрольным точкам (ListCheckpoints), отрезки обходятся задачами WorkStealingPool.
+// Пока алгоритм работает, список нельзя менять; функции, переданные в алгоритм, вызываются из разных потоков
+
+// Контрольные точки списка: итераторы на каждый K-й узел, делящие список на отрезки примерно равной длины.
+// Строятся одним последовательным проходом и переиспользуются между вызовами алгоритмов.
+// Вставки их не портят: новые узлы просто удлиняют отрезки. Когда узлы уходят из списка или меняют порядок,
+// меняется GetStructureVersion() списка, и при следующем Update точки строятся заново.
+// Точки перестраиваются и тогда, когда список с момента построения вырос вдвое и отрезки перестали быть равными
+template <typename List>
+class ListCheckpoints {
+public:
+    using ConstIterator = typename List::ConstIterator;
+
+    ListCheckpoints() = default;
+
+    ListCheckpoints(const List& list, size_t segments) {
+        Update(list, segments);
+    }
+
+    // Готовит точки для деления list на segments отрезков (но не больше, чем в нём элементов).
+    // Перестраивает их, только если прежние не подходят. Возвращает true, если пришлось перестроить
+    bool Update(const List& list, size_t segments) {
+        segments = std::max<size_t>(1, std::min(segments, list.GetSize()));
+        if (IsValidFor(list) && segments == requested_ && list.GetSize() < 2 * built_size_) {
+            return false;
+        }
+        Rebuild(list, segments);
+        return true;
+    }
+
+    // Построены ли точки для list и не ушли ли с тех пор узлы из него
+    [[nodiscard]] bool IsValidFor(const List& list) const noexcept {
+        return list_ == &list && version_ == list.GetStructureVersion();
+    }
+
+    // Число отрезков; у пустого списка — 0
+    [[nodiscard]] size_t GetSegmentCount() const noexcept {
+        return list_ && list_->IsEmpty() ? 0 : inner_.size() + 1;
+    }
+
+    // Начало отрезка index. Первый отрезок начинается с текущего begin(): он мог измениться после PushFront
+    [[nodiscard]] ConstIterator GetSegmentBegin(size_t index) const noexcept {
+        return index == 0 ? list_->begin() : inner_[index - 1];
+    }
+
+    [[nodiscard]] ConstIterator GetSegmentEnd(size_t index) const noexcept {
+        return index < inner_.size() ? inner_[index] : list_->end();
+    }
+
+private:
+    void Rebuild(const List& list, size_t segments) {
+        inner_.clear();
+        inner_.reserve(segments - 1);
+        const size_t size = list.GetSize();
+        // Отрезок i начинается с элемента i * size / segments
+        size_t position = 0;
+        size_t segment = 1;
+        for (auto it = list.begin(); segment < segments; ++it, ++position) {
+            if (position == segment * size / segments) {
+                inner_.push_back(it);
+                ++segment;
+            }
+        }
+        list_ = &list;
+        version_ = list.GetStructureVersion();
+        requested_ = segments;
+        built_size_ = size;
+    }
+
+    const List* list_ = nullptr;
+    size_t version_ = 0;
+    size_t requested_ = 0;
+    size_t built_size_ = 0;
+    // Начала отрезков 1..n-1
+    std::vector<ConstIterator> inner_;
+};
+
+namespace parallel_list_detail {
+
+// Меньше этого отрезки не делаются: раздача задачи дороже обхода пары тысяч узлов
+inline constexpr size_t kMinSegmentSize = 2048;
+// Отрезков больше, чем потоков, чтобы перехват работы выравнивал неравномерную нагрузку
+inline constexpr size_t kSegmentsPerThread = 4;
+
+inline size_t ChooseSegmentCount(size_t size, const WorkStealingPool& pool) noexcept {
+    if (pool.GetThreadCount() == 1) {
+        return 1;
+    }
+    return std::min(pool.GetThreadCount() * kSegmentsPerThread, std::max<size_t>(1, size / kMinSegmentSize));
+}
+
+// Готовит точки под число потоков пула и возвращает число отрезков
+template <typename List>
+size_t PrepareSegments(const List& list, ListCheckpoints<List>& checkpoints, const WorkStealingPool& pool) {
+    checkpoints.Update(list, ChooseSegmentCount(list.GetSize(), pool));
+    return checkpoints.GetSegmentCount();
+}
+
+// Вызывает visit(first, last, index) для каждого из segments отрезков, подготовленных PrepareSegments
+template <typename List, typename Visitor>
+void ForEachSegment(const ListCheckpoints<List>& checkpoints, size_t segments, WorkStealingPool& pool, Visitor&& visit) {
+    pool.ParallelFor(segments, [&](size_t index) {
+        visit(checkpoints.GetSegmentBegin(index), checkpoints.GetSegmentEnd(index), index);
+    });
+}
+
+}  // namespace parallel_list_detail
+
+// Вызывает f(value) для каждого элемента. Порядок вызовов не определён
+template <typename List, typename Function>
+void ParallelForEach(const List& list, ListCheckpoints<List>& checkpoints, Function f,
+                     WorkStealingPool& pool = WorkStealingPool::Default()) {
+    const size_t segments = parallel_list_detail::PrepareSegments(list, checkpoints, pool);
+    parallel_list_detail::ForEachSegment(checkpoints, segments, pool, [&f](auto first, auto last, size_t) {
+        for (; first != last; ++first) {
+            f(*first);
+        }
+    });
+}
+
+template <typename List, typename Function>
+void ParallelForEach(const List& list, Function f, WorkStealingPool& pool = WorkStealingPool::Default()) {
+    ListCheckpoints<List> checkpoints;
+    ParallelForEach(list, checkpoints, std::move(f), pool);
+}
+
+// Как std::transform_reduce: reduce(... reduce(init, transform(x1)) ..., transform(xn)).
+// Частичные результаты отрезков сворачиваются по порядку, поэтому reduce достаточно быть ассоциативной
+template <typename List, typename Result, typename Reduce, typename Transform>
+Result ParallelTransformReduce(const List& list, ListCheckpoints<List>& checkpoints, Result init, Reduce reduce,
+                               Transform transform, WorkStealingPool& pool = WorkStealingPool::Default()) {
+    const size_t segments = parallel_list_detail::PrepareSegments(list, checkpoints, pool);
+    std::vector<std::optional<Result>> partials(segments);
+    parallel_list_detail::ForEachSegment(checkpoints, segments, pool, [&](auto first, auto last, size_t index) {
+        Result partial = transform(*first);
+        for (++first; first != last; ++first) {
+            partial = reduce(std::move(partial), transform(*first));
+        }
+        partials[index].emplace(std::move(partial));
+    });
+    for (auto& partial : partials) {
+        init = reduce(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+template <typename List, typename Result, typename Reduce, typename Transform>
+Result ParallelTransformReduce(const List& list, Result init, Reduce reduce, Transform transform,
+                               WorkStealingPool& pool = WorkStealingPool::Default()) {
+    ListCheckpoints<List> checkpoints;
+    return ParallelTransformReduce(list, checkpoints, std::move(init), std::move(reduce), std::move(transform), pool);
+}
+
+// Сколько элементов удовлетворяют pred
+template <typename List, typename Predicate>
+size_t ParallelCountIf(const List& list, ListCheckpoints<List>& checkpoints, Predicate pred,
+                       WorkStealingPool& pool = WorkStealingPool::Default()) {
+    return ParallelTransformReduce(list, checkpoints, size_t{0}, std::plus<>{}, [&pred](const auto& value) -> size_t {
+        return pred(value) ? 1 : 0;
+    }, pool);
+}
+
+template <typename List, typename Predicate>
+size_t ParallelCountIf(const List& list, Predicate pred, WorkStealingPool& pool = WorkStealingPool::Default()) {
+    ListCheckpoints<List> checkpoints;
+    return ParallelCountIf(list, checkpoints, std::move(pred), pool);
+}
@@ -0,0 +1,245 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+// Неизменяемый (персистентный) односвязный список со структурным разделением.
+// Узлы не меняются после создания и принадлежат всем версиям, которые до них дотягиваются;
+// живут они, пока на них есть ссылки (атомарный счётчик ссылок в узле).
+// Копирование — O(1), PushFront/EmplaceFront возвращают новую версию, разделяющую хвост со старой,
+// PopFront — O(1) и не меняет другие версии.
+// Разные объекты-версии можно копировать и уничтожать из разных потоков одновременно, даже если у них общие узлы;
+// один и тот же объект, как и std::shared_ptr, нельзя без синхронизации менять из нескольких потоков.
+// Цепочка, на которую больше никто не ссылается, освобождается в цикле, а не рекурсивно,
+// поэтому уничтожение длинного списка не переполняет стек
+template <typename Type>
+class PersistentSingleLinkedList {
+    struct Node {
+        template <typename... Args>
+        explicit Node(const Node* next, Args&&... args) : next_node(next), value(std::forward<Args>(args)...) {}
+
+        mutable std::atomic<size_t> refs{1};
+        // Ссылка на следующий узел — одна из учтённых в его refs
+        const Node* next_node;
+        const Type value;
+    };
+
+public:
+    // Элементы менять нельзя, поэтому итератор только константный
+    class ConstIterator {
+        friend class PersistentSingleLinkedList;
+
+        explicit ConstIterator(const Node* node) : node_(node) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIterator() = default;
+
+        [[nodiscard]] bool operator==(const ConstIterator& rhs) const noexcept {
+            return node_ == rhs.node_;
+        }
+
+        [[nodiscard]] bool operator!=(const ConstIterator& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        ConstIterator& operator++() noexcept {
+            node_ = node_->next_node;
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return node_->value;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &node_->value;
+        }
+
+    private:
+        const Node* node_ = nullptr;
+    };
+
+    using value_type = Type;
+    using const_reference = const Type&;
+    using Iterator = ConstIterator;
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return ConstIterator(head_);
+    }
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return ConstIterator(nullptr);
+    }
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return end();
+    }
+
+public:
+    PersistentSingleLinkedList() = default;
+
+    PersistentSingleLinkedList(std::initializer_list<Type> values) {
+        // Узлы строятся с конца: каждый новый ссылается на уже готовый хвост.
+        // Сборка идёт в локальном объекте: если копирование элемента бросит исключение, деструктор *this не вызовется,
+        // а готовый хвост освободит деструктор temp
+        PersistentSingleLinkedList temp;
+        for (auto it = std::rbegin(values); it != std::rend(values); ++it) {
+            temp = temp.PushFront(*it);
+        }
+        swap(temp);
+    }
+
+    // O(1): версии разделяют все узлы
+    PersistentSingleLinkedList(const PersistentSingleLinkedList& other) noexcept
+        : head_(AddRef(other.head_))
+        , size_(other.size_) {}
+
+    PersistentSingleLinkedList(PersistentSingleLinkedList&& other) noexcept
+        : head_(std::exchange(other.head_, nullptr))
+        , size_(std::exchange(other.size_, 0)) {}
+
+    PersistentSingleLinkedList& operator=(const PersistentSingleLinkedList& rhs) noexcept {
+        // Сначала захватываем новые узлы: rhs может разделять узлы с *this
+        PersistentSingleLinkedList temp(rhs);
+        swap(temp);
+        return *this;
+    }
+
+    PersistentSingleLinkedList& operator=(PersistentSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            PersistentSingleLinkedList temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~PersistentSingleLinkedList() {
+        Release(head_);
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] const_reference front() const noexcept {
+        assert(!IsEmpty());
+        return head_->value;
+    }
+
+    // Новая версия с value в начале; хвост — все узлы этой версии
+    [[nodiscard]] PersistentSingleLinkedList PushFront(const Type& value) const {
+        return EmplaceFront(value);
+    }
+
+    [[nodiscard]] PersistentSingleLinkedList PushFront(Type&& value) const {
+        return EmplaceFront(std::move(value));
+    }
+
+    template <typename... Args>
+    [[nodiscard]] PersistentSingleLinkedList EmplaceFront(Args&&... args) const {
+        // Если конструктор Type бросит исключение, захваченная ссылка на хвост вернётся
+        const Node* tail = AddRef(head_);
+        try {
+            return PersistentSingleLinkedList(new Node(tail, std::forward<Args>(args)...), size_ + 1);
+        } catch (...) {
+            Release(tail);
+            throw;
+        }
+    }
+
+    // Версия без первого элемента. Для пустого списка — неопределённое поведение
+    [[nodiscard]] PersistentSingleLinkedList PopFront() const noexcept {
+        assert(!IsEmpty());
+        return PersistentSingleLinkedList(AddRef(head_->next_node), size_ - 1);
+    }
+
+    // Разделяют ли версии первый узел (а значит, и весь список)
+    [[nodiscard]] bool SharesNodesWith(const PersistentSingleLinkedList& other) const noexcept {
+        return head_ && head_ == other.head_;
+    }
+
+    void swap(PersistentSingleLinkedList& other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    PersistentSingleLinkedList(const Node* head, size_t size) noexcept : head_(head), size_(size) {}
+
+    static const Node* AddRef(const Node* node) noexcept {
+        if (node) {
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return node;
+    }
+
+    // Снимает ссылку с node; узлы, на которые больше никто не ссылается, удаляются по цепочке
+    static void Release(const Node* node) noexcept {
+        while (node && node->refs.fetch_sub(1, std::memory_order_release) == 1) {
+            // Все изменения узла другими потоками должны быть видны до его удаления
+            std::atomic_thread_fence(std::memory_order_acquire);
+            delete std::exchange(node, node->next_node);
+        }
+    }
+
+    const Node* head_ = nullptr;
+    size_t size_ = 0;
+};
+
+
+template <typename Type>
+void swap(PersistentSingleLinkedList<Type>& lhs, PersistentSingleLinkedList<Type>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type>
+bool operator==(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && (lhs.SharesNodesWith(rhs) || std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type>
+bool operator!=(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type>
+bool operator<(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type>
+bool operator<=(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type>
+bool operator>(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type>
+bool operator>=(const PersistentSingleLinkedList<Type>& lhs, const PersistentSingleLinkedList<Type>& rhs) {
+    return !(lhs < rhs);
+}
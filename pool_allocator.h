@@ -0,0 +1,244 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Пул для узлов списка.
+// Нарезает объекты одинакового размера из больших непрерывных блоков (slab),
+// освобождённые объекты складывает в свой free list и отдаёт их при следующих аллокациях.
+// Память slab'ов возвращается системе только целиком: в Release() или в деструкторе.
+// Наследуется от std::pmr::memory_resource, поэтому годится и для std::pmr::polymorphic_allocator.
+// Не потокобезопасен
+class NodePoolResource : public std::pmr::memory_resource {
+public:
+    explicit NodePoolResource(size_t slots_per_slab = 4096)
+        : slots_per_slab_(slots_per_slab ? slots_per_slab : 1) {}
+
+    NodePoolResource(const NodePoolResource&) = delete;
+    NodePoolResource& operator=(const NodePoolResource&) = delete;
+
+    ~NodePoolResource() override {
+        Release();
+    }
+
+    // Выделяет count подряд идущих слотов размером slot_size.
+    // Каждый из них потом можно вернуть по отдельности через Deallocate(p, slot_size, 1)
+    void* Allocate(size_t slot_size, size_t count) {
+        SizeClass& size_class = GetSizeClass(slot_size);
+        void* result = nullptr;
+        if (count == 1 && size_class.free_list) {
+            FreeSlot* slot = size_class.free_list;
+            size_class.free_list = slot->next;
+            result = slot;
+        } else {
+            const size_t bytes = size_class.slot_size * count;
+            if (static_cast<size_t>(size_class.bump_end - size_class.bump_begin) < bytes) {
+                AddSlab(size_class, count);
+            }
+            result = size_class.bump_begin;
+            size_class.bump_begin += bytes;
+        }
+        live_slots_ += count;
+        return result;
+    }
+
+    // Возвращает count слотов, начиная с p, в free list. Системе память не отдаётся.
+    // p должен быть выделен этим пулом (Allocate) с тем же slot_size
+    void Deallocate(void* p, size_t slot_size, size_t count) noexcept {
+        SizeClass* found = FindSizeClass(slot_size);
+        assert(found && "slot_size was never allocated from this pool");
+        if (!found) {
+            // Чужой слот в free list другого размера испортил бы пул: лучше потерять его
+            return;
+        }
+        SizeClass& size_class = *found;
+        char* slot_ptr = static_cast<char*>(p);
+        for (size_t i = 0; i < count; ++i, slot_ptr += size_class.slot_size) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(slot_ptr);
+            slot->next = size_class.free_list;
+            size_class.free_list = slot;
+        }
+        live_slots_ -= count;
+    }
+
+    // Если все живые слоты пула принадлежат вызывающему (их ровно expected_live),
+    // отдаёт все slab'ы разом и возвращает true. Иначе ничего не делает
+    bool TryReleaseAll(size_t expected_live) noexcept {
+        if (live_slots_ != expected_live) {
+            return false;
+        }
+        Release();
+        return true;
+    }
+
+    // Освобождает все slab'ы. Все выданные ранее указатели становятся невалидными
+    void Release() noexcept {
+        while (slabs_) {
+            SlabHeader* next = slabs_->next;
+            ::operator delete(slabs_);
+            slabs_ = next;
+        }
+        size_classes_.clear();
+        live_slots_ = 0;
+    }
+
+    [[nodiscard]] size_t GetLiveSlots() const noexcept {
+        return live_slots_;
+    }
+
+    // Сколько slab'ов взято у системы; пока число не растёт, аллокации обслуживаются без operator new
+    [[nodiscard]] size_t GetSlabCount() const noexcept {
+        size_t count = 0;
+        for (const SlabHeader* slab = slabs_; slab; slab = slab->next) {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    // Заголовок slab'а, за ним (с выравниванием max_align_t) идут слоты
+    struct alignas(std::max_align_t) SlabHeader {
+        SlabHeader* next;
+    };
+
+    struct SizeClass {
+        size_t slot_size = 0;
+        FreeSlot* free_list = nullptr;
+        char* bump_begin = nullptr;
+        char* bump_end = nullptr;
+    };
+
+    static size_t RoundSlotSize(size_t size) noexcept {
+        constexpr size_t align = alignof(std::max_align_t);
+        size = size < sizeof(FreeSlot) ? sizeof(FreeSlot) : size;
+        return (size + align - 1) / align * align;
+    }
+
+    // Размеров узлов немного (обычно один), поэтому линейный поиск. nullptr, если слоты такого размера не выделялись
+    SizeClass* FindSizeClass(size_t slot_size) noexcept {
+        const size_t rounded = RoundSlotSize(slot_size);
+        for (SizeClass& size_class : size_classes_) {
+            if (size_class.slot_size == rounded) {
+                return &size_class;
+            }
+        }
+        return nullptr;
+    }
+
+    SizeClass& GetSizeClass(size_t slot_size) {
+        const size_t rounded = RoundSlotSize(slot_size);
+        for (SizeClass& size_class : size_classes_) {
+            if (size_class.slot_size == rounded) {
+                return size_class;
+            }
+        }
+        size_classes_.push_back(SizeClass{rounded});
+        return size_classes_.back();
+    }
+
+    // Остаток текущего slab'а пропадает до Release(): на фоне размера slab'а это немного
+    void AddSlab(SizeClass& size_class, size_t min_slots) {
+        const size_t slots = min_slots > slots_per_slab_ ? min_slots : slots_per_slab_;
+        const size_t bytes = sizeof(SlabHeader) + slots * size_class.slot_size;
+        SlabHeader* slab = static_cast<SlabHeader*>(::operator new(bytes));
+        slab->next = slabs_;
+        slabs_ = slab;
+        size_class.bump_begin = reinterpret_cast<char*>(slab + 1);
+        size_class.bump_end = size_class.bump_begin + slots * size_class.slot_size;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (alignment > alignof(std::max_align_t)) {
+            throw std::bad_alloc();
+        }
+        return Allocate(bytes, 1);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t /*alignment*/) override {
+        Deallocate(p, bytes, 1);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    size_t slots_per_slab_;
+    std::vector<SizeClass> size_classes_;
+    SlabHeader* slabs_ = nullptr;
+    size_t live_slots_ = 0;
+};
+
+
+// Аллокатор в стиле std::allocator_traits поверх NodePoolResource.
+// Копии аллокатора (в том числе после rebind на тип узла) разделяют один пул;
+// пул живёт, пока жив хотя бы один использующий его аллокатор
+template <typename T>
+class PoolAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+    template <typename U>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    // Аллокатор — лишь ручка на пул, поэтому ручку можно свободно передавать между списками
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    // Память, выделенную allocate(n), можно возвращать по одному объекту (deallocate(p + i, 1)),
+    // если шаг массива совпадает с размером слота пула
+    using allows_partial_deallocation = std::bool_constant<sizeof(T) % alignof(std::max_align_t) == 0>;
+
+    PoolAllocator()
+        : resource_(std::make_shared<NodePoolResource>()) {}
+
+    explicit PoolAllocator(std::shared_ptr<NodePoolResource> resource) noexcept
+        : resource_(std::move(resource)) {}
+
+    // Копирование объявлено явно, поэтому перемещение тоже копирует ручку: список, из которого переместили узлы,
+    // остаётся привязан к пулу и может дальше выделять узлы и вызывать TryReleaseAll
+    PoolAllocator(const PoolAllocator&) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator&) noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : resource_(other.resource_) {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        return static_cast<T*>(resource_->Allocate(sizeof(T), n));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        resource_->Deallocate(p, sizeof(T), n);
+    }
+
+    // Массовое освобождение, см. NodePoolResource::TryReleaseAll
+    bool TryReleaseAll(size_t expected_live) noexcept {
+        return resource_->TryReleaseAll(expected_live);
+    }
+
+    [[nodiscard]] NodePoolResource& GetResource() const noexcept {
+        return *resource_;
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& rhs) const noexcept {
+        return resource_ == rhs.resource_;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    std::shared_ptr<NodePoolResource> resource_;
+};
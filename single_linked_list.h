@@ -1,30 +1,61 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "list_reclaimer.h"
+#include "list_serialization.h"
+#include "list_stats.h"
 
 using namespace std::string_literals; 
 
-template <typename Type>
+// Stats — политика инструментирования (см. list_stats.h), по умолчанию ничего не считает
+template <typename Type, typename Allocator = std::allocator<Type>, typename Stats = DefaultListStats>
 class SingleLinkedList {
+    struct Node;
+
+    // Часть узла без значения. Из неё одной состоит фиктивный узел head_,
+    // поэтому он хранится прямо в объекте списка и не требует ни аллокации, ни конструктора Type
+    struct NodeBase {
+        Node* next_node = nullptr;
+    };
+
     // Узел списка
-    struct Node {
-        Node() = default;
-        Node(const Type& val, Node* next) : value(val), next_node(next) {}
+    struct Node : NodeBase {
+        // Значение конструируется прямо в узле из переданных аргументов
+        template <typename... Args>
+        explicit Node(Node* next, Args&&... args) : NodeBase{next}, value(std::forward<Args>(args)...) {}
 
         Type value;
-        Node* next_node = nullptr;
     };
 
+    // Узлы выделяются аллокатором, перепривязанным (rebind) с Type на Node
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
 
     // Шаблон класса «Базовый Итератор».
     // Определяет поведение итератора на элементы односвязного списка
     // ValueType — совпадает с Type (для Iterator) либо с const Type (для ConstIterator)
-    template <typename ValueType>
+    // Prefetch — политика обхода: при true каждый ++ заранее запрашивает в кеш узел, следующий за новым текущим,
+    // чтобы его загрузка шла, пока обрабатывается текущий элемент (см. WithPrefetch())
+    template <typename ValueType, bool Prefetch = false>
     class BasicIterator {
         // Класс списка объявляется дружественным, чтобы из методов списка был доступ к приватной области итератора
         friend class SingleLinkedList;
+        template <typename, bool>
+        friend class BasicIterator;
 
-        // Конвертирующий конструктор из указателя на узел списка
-        explicit BasicIterator(Node* node) : node_(node) {}
+        // Конвертирующий конструктор из указателя на узел списка и статистики списка
+        BasicIterator(NodeBase* node, const Stats* stats) : node_(node), hook_(stats) {}
 
     public:
         // Объявленные ниже типы сообщают стандартной библиотеке о свойствах этого итератора
@@ -44,126 +75,200 @@ class SingleLinkedList {
         // Конвертирующий конструктор/конструктор копирования
         // При ValueType, совпадающем с Type, играет роль копирующего конструктора
         // При ValueType, совпадающем с const Type, играет роль конвертирующего конструктора
-        BasicIterator(const BasicIterator<Type>& other) noexcept { node_ = other.node_; }
+        BasicIterator(const BasicIterator<Type, Prefetch>& other) noexcept : node_(other.node_), hook_(other.hook_) {}
+
+        // Смена политики обхода: из обычного итератора в предвыбирающий и обратно
+        template <typename OtherValueType, typename = std::enable_if_t<std::is_convertible_v<OtherValueType*, ValueType*>>>
+        explicit BasicIterator(const BasicIterator<OtherValueType, !Prefetch>& other) noexcept
+            : node_(other.node_), hook_(other.hook_) {}
 
         // Операторы ++ * -> для несуществующих элементов приводят к неопределенному поведению 
 
         BasicIterator& operator=(const BasicIterator& rhs) = default;
 
-        // Оператор сравнения итераторов (в роли второго аргумента *константный* итератор)
-        // Два итератора равны, если они ссылаются на один и тот же элемент списка либо на end()
-        [[nodiscard]] bool operator==(const BasicIterator<const Type>& rhs) const noexcept {
-            return (node_ == rhs.node_); 
-        }
-
-        [[nodiscard]] bool operator!=(const BasicIterator<const Type>& rhs) const noexcept {
-            return !(*this == rhs); 
-        }
-
-        // Оператор сравнения итераторов (в роли второго аргумента итератор)
+        // Оператор сравнения итераторов (в роли второго аргумента константный или неконстантный итератор с любой политикой)
         // Два итератора равны, если они ссылаются на один и тот же элемент списка либо на end()
-        [[nodiscard]] bool operator==(const BasicIterator<Type>& rhs) const noexcept {
+        template <typename OtherValueType, bool OtherPrefetch>
+        [[nodiscard]] bool operator==(const BasicIterator<OtherValueType, OtherPrefetch>& rhs) const noexcept {
             return (node_ == rhs.node_); 
         }
 
-        [[nodiscard]] bool operator!=(const BasicIterator<Type>& rhs) const noexcept {
+        template <typename OtherValueType, bool OtherPrefetch>
+        [[nodiscard]] bool operator!=(const BasicIterator<OtherValueType, OtherPrefetch>& rhs) const noexcept {
             return !(*this == rhs); 
         }
 
         // Оператор прединкремента. После его вызова итератор указывает на следующий элемент списка
         // Возвращает ссылку на самого себя
         BasicIterator& operator++() noexcept {
+            hook_.OnStep(); 
             node_ = node_->next_node; 
+            if constexpr (Prefetch) {
+                if (node_) {
+                    PrefetchNode(node_->next_node); 
+                }
+            }
             return *this; 
         }
 
         // Оператор постинкремента. После его вызова итератор указывает на следующий элемент списка
         // Возвращает прежнее значение итератора
         BasicIterator operator++(int) noexcept {
-            BasicIterator temp_it (node_->next_node); 
-            std::swap(*this, temp_it); 
-            return temp_it; 
+            BasicIterator old(*this); 
+            ++(*this); 
+            return old; 
         }
 
         [[nodiscard]] reference operator*() const noexcept {
-            return node_->value; 
+            return static_cast<Node*>(node_)->value; 
         }
 
         [[nodiscard]] pointer operator->() const noexcept {
-            return &node_->value; 
+            return &static_cast<Node*>(node_)->value; 
         }
 
     private:
-        Node* node_ = nullptr;
+        NodeBase* node_ = nullptr;
+        // При выключенной статистике пуст и места не занимает
+        [[no_unique_address]] typename Stats::IteratorHook hook_;
     };
 
 public:
     using value_type = Type;
     using reference = value_type&;
     using const_reference = const value_type&;
+    using allocator_type = Allocator;
 
     // Итератор, допускающий изменение элементов списка
     using Iterator = BasicIterator<Type>;
     // Константный итератор, предоставляющий доступ для чтения к элементам списка
     using ConstIterator = BasicIterator<const Type>;
+    // Итераторы с предвыборкой следующего узла, см. WithPrefetch()
+    using PrefetchingIterator = BasicIterator<Type, true>;
+    using PrefetchingConstIterator = BasicIterator<const Type, true>;
+
+    // Пара итераторов для range-based for
+    template <typename RangeIterator>
+    struct Range {
+        RangeIterator first; 
+        RangeIterator last; 
+
+        [[nodiscard]] RangeIterator begin() const noexcept {
+            return first; 
+        }
+        [[nodiscard]] RangeIterator end() const noexcept {
+            return last; 
+        }
+    };
 
     // Нельзя разыменовывать .end() и .before_begin() - неопределенное поведение
     // Если список пустой, begin() == end()
 
     // Возвращает итератор, ссылающийся на первый элемент
     [[nodiscard]] Iterator begin() noexcept {
-        return Iterator(head_->next_node); 
+        return Iterator(head_.next_node, &stats_); 
     }
     [[nodiscard]] ConstIterator cbegin() const noexcept {
-        return Iterator(head_->next_node);
+        return Iterator(head_.next_node, &stats_);
     }
     // эквивалентен cbegin()
     [[nodiscard]] ConstIterator begin() const noexcept {
-        return Iterator(head_->next_node);
+        return Iterator(head_.next_node, &stats_);
     }
 
     // Возвращает итератор, указывающий на позицию, следующую за последним элементом односвязного списка
     [[nodiscard]] Iterator end() noexcept {
-        return Iterator(nullptr); 
+        return Iterator(nullptr, &stats_); 
     }
     [[nodiscard]] ConstIterator cend() const noexcept {
-        return Iterator(nullptr); 
+        return Iterator(nullptr, &stats_); 
     }
     // эквивалентен cend()
     [[nodiscard]] ConstIterator end() const noexcept {
-        return Iterator(nullptr); 
+        return Iterator(nullptr, &stats_); 
     }
 
 
     // Возвращает итератор, указывающий на позицию перед первым элементом односвязного списка.
     [[nodiscard]] Iterator before_begin() noexcept {
-        return Iterator(head_);
+        return Iterator(&head_, &stats_);
     }
 
     [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
-        return Iterator(head_);
+        return Iterator(const_cast<NodeBase*>(&head_), &stats_);
     }
     
     [[nodiscard]] ConstIterator before_begin() const noexcept {
-        return Iterator(head_);
+        return cbefore_begin();
+    }
+
+    // Возвращает итератор на последний элемент (для пустого списка совпадает с before_begin())
+    // Вставка после него — добавление в конец за O(1)
+    [[nodiscard]] Iterator before_end() noexcept {
+        return Iterator(tail_, &stats_);
+    }
+
+    [[nodiscard]] ConstIterator cbefore_end() const noexcept {
+        return Iterator(tail_, &stats_);
+    }
+
+    [[nodiscard]] ConstIterator before_end() const noexcept {
+        return cbefore_end();
+    }
+
+
+
+    // Весь список с итераторами, которые предвыбирают следующий узел:
+    // for (auto& value : list.WithPrefetch()) { ... }
+    // Выигрыш есть, когда обработка элемента занимает заметное время по сравнению с промахом кеша
+    [[nodiscard]] Range<PrefetchingIterator> WithPrefetch() noexcept {
+        return {PrefetchingIterator(begin()), PrefetchingIterator(end())}; 
     }
 
+    [[nodiscard]] Range<PrefetchingConstIterator> WithPrefetch() const noexcept {
+        return {PrefetchingConstIterator(begin()), PrefetchingConstIterator(end())}; 
+    }
 
 
 public:
-    SingleLinkedList() : head_(new Node()) {}
+    SingleLinkedList() = default;
+
+    explicit SingleLinkedList(const Allocator& alloc) : alloc_(alloc) {}
 
-    SingleLinkedList(std::initializer_list<Type> values) : head_(new Node()) {
+    SingleLinkedList(std::initializer_list<Type> values, const Allocator& alloc = Allocator()) : alloc_(alloc) {
         FillWithValues(values.begin(), values.end());
     }
 
-    SingleLinkedList(const SingleLinkedList& other) : head_(new Node()) {
+    SingleLinkedList(const SingleLinkedList& other) 
+        : alloc_(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        FillWithValues(other.begin(), other.end());
+    }
+
+    SingleLinkedList(const SingleLinkedList& other, const Allocator& alloc) : alloc_(alloc) {
         FillWithValues(other.begin(), other.end());
     }
+
+    // Забирает узлы other за O(1), other остаётся пустым.
+    // Аллокатор копируется, а не перемещается: опустевший other продолжает выделять и освобождать узлы им
+    SingleLinkedList(SingleLinkedList&& other) noexcept : alloc_(other.alloc_) {
+        StealNodes(other); 
+    }
+
+    // Узлы можно забрать, только если их освободит переданный аллокатор, иначе значения перемещаются поэлементно
+    SingleLinkedList(SingleLinkedList&& other, const Allocator& alloc) : alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            StealNodes(other); 
+        } else {
+            FillWithValues(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end())); 
+        }
+    }
     
     ~SingleLinkedList() {
         Clear();
-        delete head_; 
+    }
+
+    [[nodiscard]] allocator_type GetAllocator() const noexcept {
+        return allocator_type(alloc_);
     }
 
     [[nodiscard]] size_t GetSize() const noexcept {
@@ -174,41 +279,237 @@ public:
         return size_ == 0;
     }
 
+    // Структурная версия: меняется, когда узлы уходят из списка или меняют порядок
+    // (EraseAfter, Clear, Splice, Sort, RemoveIf, Compact, swap, перемещение и присваивание).
+    // Вставки её не меняют: узлы, которые уже были в списке, остаются в нём в прежнем порядке.
+    // Новый список получает версию, которой не было ни у одного списка этого типа, даже по тому же адресу.
+    // По ней ListCheckpoints (parallel_list_algorithms.h) узнаёт, что запомненные узлы могли устареть
+    [[nodiscard]] size_t GetStructureVersion() const noexcept {
+        return structure_version_; 
+    }
+
+    // Снимок счётчиков списка. При выключенной статистике (NoListStats) все поля нулевые
+    [[nodiscard]] ListStats GetStats() const noexcept {
+        return stats_.GetSnapshot(); 
+    }
+
     void PushFront(const Type& value) {
-        head_->next_node = new Node(value, head_->next_node); 
-        ++size_; 
+        EmplaceFront(value); 
+    }
+
+    void PushFront(Type&& value) {
+        EmplaceFront(std::move(value)); 
+    }
+
+    // Конструирует элемент в начале списка из args без промежуточных копий
+    // Возвращает ссылку на вставленный элемент
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        return *EmplaceAfter(before_begin(), std::forward<Args>(args)...); 
+    }
+
+    // Добавление в конец за O(1): список хранит указатель на последний узел
+    void PushBack(const Type& value) {
+        EmplaceBack(value); 
+    }
+
+    void PushBack(Type&& value) {
+        EmplaceBack(std::move(value)); 
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *EmplaceAfter(before_end(), std::forward<Args>(args)...); 
+    }
+
+    // Первый и последний элементы. Для пустого списка — неопределённое поведение
+    [[nodiscard]] reference front() noexcept {
+        assert(!IsEmpty()); 
+        return head_.next_node->value; 
+    }
+
+    [[nodiscard]] const_reference front() const noexcept {
+        assert(!IsEmpty()); 
+        return head_.next_node->value; 
+    }
+
+    [[nodiscard]] reference back() noexcept {
+        assert(!IsEmpty()); 
+        return static_cast<Node*>(tail_)->value; 
+    }
+
+    [[nodiscard]] const_reference back() const noexcept {
+        assert(!IsEmpty()); 
+        return static_cast<const Node*>(tail_)->value; 
     }
 
     void Clear() noexcept {
-        while (head_->next_node) {
-            Node* tmp = head_->next_node;
-            head_->next_node = head_->next_node->next_node; 
-            delete tmp;      
+        stats_.OnClear(size_); 
+        OnRelink(); 
+        // Узлы без деструкторов незачем обходить, если аллокатор умеет отдать свою память целиком
+        if constexpr (std::is_trivially_destructible_v<Type> && HasBulkRelease<NodeAllocator>(0)) {
+            if (alloc_.TryReleaseAll(size_)) {
+                stats_.OnDeallocate(size_); 
+                head_.next_node = nullptr;
+                tail_ = &head_;
+                size_ = 0;
+                stats_.OnResize(0); 
+                return;
+            }
         }
+        while (head_.next_node) {
+            Node* tmp = head_.next_node;
+            head_.next_node = head_.next_node->next_node; 
+            DestroyNode(tmp);      
+        }
+        tail_ = &head_;
         size_ = 0;
+        stats_.OnResize(0); 
+    }
+
+    // Как Clear(), но элементы уничтожаются и память освобождается в фоновом потоке reclaimer,
+    // а вызывающий поток отцепляет цепочку узлов и возвращается за O(1).
+    // Откладывается только работа с аллокаторами без состояния (is_always_equal, как std::allocator):
+    // их может использовать любой поток. С остальными аллокаторами (PoolAllocator, pmr), как и при
+    // нехватке памяти на постановку в очередь, выполняется обычный Clear()
+    void ClearDeferred(ListReclaimer& reclaimer = ListReclaimer::Default()) noexcept {
+        if constexpr (NodeTraits::is_always_equal::value && std::is_default_constructible_v<NodeAllocator>) {
+            if (!head_.next_node) {
+                return; 
+            }
+            try {
+                reclaimer.Submit(&ReclaimChain, head_.next_node, nullptr); 
+            } catch (...) {
+                Clear(); 
+                return; 
+            }
+            stats_.OnClear(size_); 
+            stats_.OnDeallocate(size_); 
+            OnRelink(); 
+            head_.next_node = nullptr;
+            tail_ = &head_;
+            size_ = 0;
+            stats_.OnResize(0); 
+        } else {
+            Clear(); 
+        }
     }
 
     SingleLinkedList& operator=(const SingleLinkedList& rhs) {
         if (this != &rhs) {
-            SingleLinkedList temp(rhs); 
-            swap(temp); 
+            if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != rhs.alloc_) {
+                    // Узлы должны освобождаться тем аллокатором, которым выделены,
+                    // поэтому сначала копируем, затем отдаём свои узлы старому аллокатору и только потом его меняем
+                    SingleLinkedList temp(rhs, rhs.alloc_); 
+                    Clear(); 
+                    alloc_ = rhs.alloc_; 
+                    swap(temp); 
+                    return *this; 
+                }
+            }
+            if constexpr (std::is_nothrow_copy_assignable_v<Type>) {
+                AssignReusingNodes(rhs); 
+            } else {
+                SingleLinkedList temp(rhs, alloc_); 
+                swap(temp); 
+            }
+        }
+        return *this; 
+    }
+
+    SingleLinkedList& operator=(SingleLinkedList&& rhs) noexcept(
+            NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value) {
+        if (this != &rhs) {
+            if constexpr (NodeTraits::propagate_on_container_move_assignment::value) {
+                Clear(); 
+                alloc_ = rhs.alloc_; 
+                StealNodes(rhs); 
+            } else {
+                if (alloc_ == rhs.alloc_) {
+                    Clear(); 
+                    StealNodes(rhs); 
+                } else {
+                    // Чужие узлы забрать нельзя: перемещаем значения в свои узлы
+                    SingleLinkedList temp(std::move(rhs), GetAllocator()); 
+                    swap(temp); 
+                }
+            }
         }
         return *this; 
     }
 
     // Обменивает содержимое списков за O(1)
+    // Если аллокатор не распространяется при обмене, аллокаторы списков должны быть равны
     void swap(SingleLinkedList& other) noexcept {
-        std::swap(head_->next_node, other.head_->next_node); 
+        if constexpr (NodeTraits::propagate_on_container_swap::value) {
+            using std::swap; 
+            swap(alloc_, other.alloc_); 
+        } else {
+            assert(alloc_ == other.alloc_); 
+        }
+        std::swap(head_.next_node, other.head_.next_node); 
+        std::swap(tail_, other.tail_); 
+        OnRelink(); 
+        other.OnRelink(); 
         std::swap(size_, other.size_); 
+        // Счётчики переезжают вместе с узлами: их итераторы считают шаги в счётчики своего списка
+        stats_.Swap(other.stats_); 
+        // У пустого списка хвост — его собственный фиктивный узел, он не переезжает
+        FixEmptyTail(); 
+        other.FixEmptyTail(); 
     }
 
 
     // Возвращает итератор на вставленный элемент
     // Если при создании элемента будет выброшено исключение, список останется в прежнем состоянии
     Iterator InsertAfter(ConstIterator pos, const Type& value) {
-        pos.node_->next_node = new Node(value, pos.node_->next_node);  
+        return EmplaceAfter(pos, value); 
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value)); 
+    }
+
+    // Конструирует элемент после pos из args без промежуточных копий
+    // Возвращает итератор на вставленный элемент, гарантии при исключениях те же, что у InsertAfter
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        pos.node_->next_node = CreateNode(pos.node_->next_node, std::forward<Args>(args)...);  
+        if (pos.node_ == tail_) {
+            tail_ = pos.node_->next_node; 
+        }
         ++size_; 
-        return Iterator(pos.node_->next_node); 
+        stats_.OnInsert(); 
+        stats_.OnResize(size_); 
+        return Iterator(pos.node_->next_node, &stats_); 
+    }
+
+    // Вставляет копии элементов [first, last) после pos в том же порядке.
+    // Возвращает итератор на последний вставленный элемент (pos, если диапазон пуст).
+    // Узлы сначала собираются в отдельную цепочку и привязываются к списку одной операцией,
+    // поэтому если при создании элементов будет выброшено исключение, список останется в прежнем состоянии
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    Iterator InsertAfter(ConstIterator pos, InputIterator first, InputIterator last) {
+        return LinkChain(pos.node_, CreateChain(first, last)); 
+    }
+
+    Iterator InsertAfter(ConstIterator pos, std::initializer_list<Type> values) {
+        return InsertAfter(pos, values.begin(), values.end()); 
+    }
+
+    // Заменяет содержимое списка копиями элементов [first, last).
+    // Новые узлы создаются (как в InsertAfter) до освобождения старых, поэтому при исключении список не меняется,
+    // а диапазон может состоять из элементов самого списка
+    template <typename InputIterator, typename = typename std::iterator_traits<InputIterator>::iterator_category>
+    void Assign(InputIterator first, InputIterator last) {
+        const Chain chain = CreateChain(first, last); 
+        Clear(); 
+        LinkChain(&head_, chain); 
+    }
+
+    void Assign(std::initializer_list<Type> values) {
+        Assign(values.begin(), values.end()); 
     }
 
     void PopFront() noexcept {
@@ -220,47 +521,705 @@ public:
         if (pos != end()) {
             Node * to_drop = pos.node_->next_node; 
             pos.node_->next_node = to_drop->next_node; 
-            delete to_drop; 
+            if (to_drop == tail_) {
+                tail_ = pos.node_; 
+            }
+            DestroyNode(to_drop); 
             --size_;
+            OnRelink(); 
+            stats_.OnErase(); 
+            stats_.OnResize(size_); 
+        }
+        return Iterator(pos.node_->next_node, &stats_); 
+    }
+
+    // Операции ниже перевешивают существующие узлы без аллокаций и копирования значений.
+    // Аллокаторы списков должны быть равны: узлы освобождает тот список, в котором они окажутся.
+    // Итераторы на перенесённые элементы остаются валидными, но указывают уже в другой список
+
+    // Переносит все элементы other после pos за O(1). other становится пустым
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other) noexcept {
+        assert(alloc_ == other.alloc_); 
+        if (&other == this || other.IsEmpty()) {
+            return; 
         }
-        return Iterator(pos.node_->next_node); 
+        OnRelink(); 
+        other.OnRelink(); 
+        NodeBase* other_last = std::exchange(other.tail_, &other.head_); 
+        other_last->next_node = pos.node_->next_node; 
+        pos.node_->next_node = std::exchange(other.head_.next_node, nullptr); 
+        if (pos.node_ == tail_) {
+            tail_ = other_last; 
+        }
+        size_ += std::exchange(other.size_, 0); 
+        stats_.OnResize(size_); 
+        other.stats_.OnResize(0); 
+    }
+
+    // Переносит элементы other из интервала (first, last) после pos. pos не должен лежать в этом интервале
+    // Сложность O(длины интервала): его нужно пройти, чтобы найти конец и пересчитать размеры.
+    // При переносе внутри одного списка размер не меняется
+    void SpliceAfter(ConstIterator pos, SingleLinkedList& other, ConstIterator first, ConstIterator last) noexcept {
+        assert(alloc_ == other.alloc_); 
+        if (first == last || first.node_->next_node == last.node_ || pos == first) {
+            return; 
+        }
+        size_t count = 1; 
+        NodeBase* range_last = first.node_->next_node; 
+        while (range_last->next_node != last.node_) {
+            range_last = range_last->next_node; 
+            ++count; 
+        }
+        if (pos.node_ == range_last) {
+            return; 
+        }
+        OnRelink(); 
+        other.OnRelink(); 
+        const bool range_was_tail = (range_last == other.tail_); 
+        const bool pos_was_tail = (pos.node_ == tail_); 
+        Node* range_first = first.node_->next_node; 
+        first.node_->next_node = range_last->next_node; 
+        range_last->next_node = pos.node_->next_node; 
+        pos.node_->next_node = range_first; 
+        if (range_was_tail) {
+            other.tail_ = first.node_; 
+        }
+        if (pos_was_tail) {
+            tail_ = range_last; 
+        }
+        if (&other != this) {
+            other.size_ -= count; 
+            size_ += count; 
+            stats_.OnResize(size_); 
+            other.stats_.OnResize(other.size_); 
+        }
+    }
+
+    // Отрезает все элементы после pos в новый список
+    // Сложность O(длины хвоста): его нужно пройти, чтобы узнать размер нового списка
+    [[nodiscard]] SingleLinkedList SplitAfter(ConstIterator pos) noexcept {
+        SingleLinkedList tail(GetAllocator()); 
+        if (!pos.node_->next_node) {
+            return tail; 
+        }
+        OnRelink(); 
+        tail.head_.next_node = std::exchange(pos.node_->next_node, nullptr); 
+        tail.tail_ = std::exchange(tail_, pos.node_); 
+        for (NodeBase* node = tail.head_.next_node; node; node = node->next_node) {
+            ++tail.size_; 
+        }
+        size_ -= tail.size_; 
+        stats_.OnResize(size_); 
+        tail.stats_.OnResize(tail.size_); 
+        return tail; 
+    }
+
+    // Переносит все элементы other в конец списка за O(1). other становится пустым
+    void Append(SingleLinkedList&& other) noexcept {
+        SpliceAfter(before_end(), other); 
+    }
+
+    // Устойчивая сортировка слиянием снизу вверх. Значения не перемещаются и не копируются —
+    // переставляются только ссылки next_node, дополнительная память O(1) (массив из 64 «корзин»).
+    // Итераторы остаются валидными. Если comp бросит исключение, порядок элементов не определён,
+    // но ни один элемент не теряется
+    template <typename Compare = std::less<>>
+    void Sort(Compare comp = Compare()) {
+        if (size_ < 2) {
+            return; 
+        }
+        OnRelink(); 
+        // В bins[i] лежит отсортированная цепочка из 2^i узлов либо nullptr.
+        // Чем больше i, тем раньше в списке стояли её элементы
+        Node* bins[64] = {}; 
+        Node* rest = std::exchange(head_.next_node, nullptr); 
+        Node* carry = nullptr; 
+        Node* result = nullptr; 
+        try {
+            while (rest) {
+                carry = rest; 
+                rest = rest->next_node; 
+                carry->next_node = nullptr; 
+                size_t i = 0; 
+                for (; bins[i]; ++i) {
+                    Node* newer = std::exchange(carry, nullptr); 
+                    MergeChains(bins[i], newer, comp); 
+                    carry = std::exchange(bins[i], nullptr); 
+                }
+                bins[i] = std::exchange(carry, nullptr); 
+            }
+            for (Node*& bin : bins) {
+                if (bin) {
+                    Node* newer = std::exchange(result, nullptr); 
+                    MergeChains(bin, newer, comp); 
+                    result = std::exchange(bin, nullptr); 
+                }
+            }
+        } catch (...) {
+            NodeBase* tail = &head_; 
+            auto attach = [&tail](Node* chain) {
+                tail->next_node = chain; 
+                tail = LastNode(tail); 
+            }; 
+            attach(carry); 
+            attach(result); 
+            for (Node* bin : bins) {
+                attach(bin); 
+            }
+            attach(rest); 
+            tail_ = tail; 
+            throw; 
+        }
+        head_.next_node = result; 
+        tail_ = LastNode(&head_); 
+    }
+
+    // Сливает отсортированный по comp список other в этот (тоже отсортированный) без аллокаций.
+    // При равных элементах элементы этого списка идут первыми. other становится пустым
+    template <typename Compare = std::less<>>
+    void Merge(SingleLinkedList& other, Compare comp = Compare()) {
+        assert(alloc_ == other.alloc_); 
+        if (&other == this) {
+            return; 
+        }
+        OnRelink(); 
+        other.OnRelink(); 
+        Node* other_chain = std::exchange(other.head_.next_node, nullptr); 
+        other.tail_ = &other.head_; 
+        size_ += std::exchange(other.size_, 0); 
+        stats_.OnResize(size_); 
+        other.stats_.OnResize(0); 
+        try {
+            MergeChains(head_.next_node, other_chain, comp); 
+        } catch (...) {
+            tail_ = LastNode(&head_); 
+            throw; 
+        }
+        tail_ = LastNode(tail_); 
+    }
+
+    // Удаляет элементы, для которых pred возвращает true. Возвращает количество удалённых
+    // Удаляемые узлы сначала собираются в отдельную цепочку и освобождаются одним проходом в конце,
+    // в том числе если pred бросит исключение
+    template <typename Predicate>
+    size_t RemoveIf(Predicate pred) {
+        RemovedChain removed(*this); 
+        NodeBase* prev = &head_; 
+        while (prev->next_node) {
+            if (pred(std::as_const(prev->next_node->value))) {
+                removed.Take(prev); 
+            } else {
+                prev = prev->next_node; 
+            }
+        }
+        return removed.count; 
+    }
+
+    size_t Remove(const Type& value) {
+        return RemoveIf([&value](const Type& item) { return item == value; }); 
+    }
+
+    // Оставляет только первый элемент из каждой группы подряд идущих равных (по pred) элементов
+    // Возвращает количество удалённых
+    template <typename BinaryPredicate = std::equal_to<>>
+    size_t Unique(BinaryPredicate pred = BinaryPredicate()) {
+        RemovedChain removed(*this); 
+        Node* kept = head_.next_node; 
+        while (kept && kept->next_node) {
+            if (pred(std::as_const(kept->value), std::as_const(kept->next_node->value))) {
+                removed.Take(kept); 
+            } else {
+                kept = kept->next_node; 
+            }
+        }
+        return removed.count; 
+    }
+
+    // Обходы ниже идут по узлам с предвыборкой на kPrefetchDistance узлов вперёд (см. VisitNodes)
+
+    // Вызывает f для каждого элемента по порядку
+    template <typename Function>
+    void ForEach(Function f) {
+        VisitNodes(head_.next_node, [&f](Node* node) {
+            f(node->value); 
+            return true; 
+        }); 
+    }
+
+    template <typename Function>
+    void ForEach(Function f) const {
+        VisitNodes(head_.next_node, [&f](Node* node) {
+            f(std::as_const(node->value)); 
+            return true; 
+        }); 
+    }
+
+    // Первый элемент, равный value, либо end()
+    [[nodiscard]] Iterator Find(const Type& value) {
+        return Iterator(FindNode(value), &stats_); 
+    }
+
+    [[nodiscard]] ConstIterator Find(const Type& value) const {
+        return Iterator(FindNode(value), &stats_); 
+    }
+
+    // Количество элементов, равных value
+    [[nodiscard]] size_t Count(const Type& value) const {
+        size_t count = 0; 
+        VisitNodes(head_.next_node, [&](Node* node) {
+            count += (std::as_const(node->value) == value) ? 1 : 0; 
+            return true; 
+        }); 
+        return count; 
+    }
+
+    // Свёртка элементов по порядку: op(...op(op(init, e1), e2)..., en), как std::accumulate
+    template <typename T, typename BinaryOperation = std::plus<>>
+    [[nodiscard]] T Accumulate(T init, BinaryOperation op = BinaryOperation()) const {
+        VisitNodes(head_.next_node, [&](Node* node) {
+            init = op(std::move(init), std::as_const(node->value)); 
+            return true; 
+        }); 
+        return init; 
+    }
+
+    // Записывает список в out в двоичном формате (см. list_serialization.h).
+    // Тривиально копируемые Type пишутся образом, пригодным для MappedSingleLinkedList, остальные — через BinaryCodec<Type>.
+    // При ошибке записи бросает std::runtime_error
+    void Serialize(std::ostream& out) const {
+        serialization_detail::Write<Type>(out, cbegin(), size_); 
+    }
+
+    // Читает список, записанный Serialize. Бросает std::runtime_error, если данные обрезаны
+    // или записаны для другого типа либо другой версией формата
+    [[nodiscard]] static SingleLinkedList Deserialize(std::istream& in, const Allocator& alloc = Allocator()) {
+        SingleLinkedList list(alloc); 
+        serialization_detail::Read<Type>(in, [&list](Type&& value) {
+            list.EmplaceBack(std::move(value)); 
+        }); 
+        return list; 
+    }
+
+    // Переносит узлы в новую память в порядке обхода, чтобы обход снова шёл по соседним адресам
+    // (после долгой работы с InsertAfter/EraseAfter или после Sort узлы разбросаны по куче).
+    // Значения перемещаются (копируются, если перемещение Type может бросить исключение), порядок и размер сохраняются.
+    // Если аллокатор разрешает возвращать память по одному узлу (allows_partial_deallocation, см. PoolAllocator),
+    // все узлы ложатся в один непрерывный блок, иначе выделяются подряд по одному, как у только что построенного списка.
+    // Инвалидирует все итераторы, указатели и ссылки на элементы, кроме before_begin() и end().
+    // Вся память выделяется до переноса первого значения, поэтому при исключении список не меняется
+    // (если только Type не копируется и его перемещение бросает исключение)
+    void Compact() {
+        if (size_ < 2) {
+            return; 
+        }
+        FreeSlot* slots = AllocateSlots(size_); 
+        OnRelink(); 
+        NodeBase compacted; 
+        NodeBase* last = &compacted; 
+        try {
+            for (Node* old = head_.next_node; old; old = old->next_node) {
+                Node* node = reinterpret_cast<Node*>(std::exchange(slots, slots->next)); 
+                try {
+                    NodeTraits::construct(alloc_, node, nullptr, std::move_if_noexcept(old->value)); 
+                } catch (...) {
+                    NodeTraits::deallocate(alloc_, node, 1); 
+                    throw; 
+                }
+                stats_.OnAllocate(); 
+                last->next_node = node; 
+                last = node; 
+            }
+        } catch (...) {
+            ReleaseSlots(slots); 
+            while (compacted.next_node) {
+                DestroyNode(std::exchange(compacted.next_node, compacted.next_node->next_node)); 
+            }
+            throw; 
+        }
+        Node* old = std::exchange(head_.next_node, compacted.next_node); 
+        tail_ = last; 
+        while (old) {
+            DestroyNode(std::exchange(old, old->next_node)); 
+        }
+        stats_.OnCompact(); 
+    }
+
+    // Доля переходов между соседними элементами, ведущих к далёкому в памяти узлу: от 0 (список только что
+    // уплотнён) до 1. Соседним считается узел, начинающийся не дальше кэш-линии после конца текущего —
+    // зазор оставляет место под служебные данные аллокатора. Сложность O(n)
+    [[nodiscard]] double GetFragmentation() const noexcept {
+        if (size_ < 2) {
+            return 0.0; 
+        }
+        constexpr std::uintptr_t kMaxGap = sizeof(Node) + 64; 
+        size_t far_links = 0; 
+        for (const Node* node = head_.next_node; node->next_node; node = node->next_node) {
+            const auto from = reinterpret_cast<std::uintptr_t>(node); 
+            const auto to = reinterpret_cast<std::uintptr_t>(node->next_node); 
+            if (to <= from || to - from > kMaxGap) {
+                ++far_links; 
+            }
+        }
+        return static_cast<double>(far_links) / static_cast<double>(size_ - 1); 
+    }
+
+    // Уплотняет список, если GetFragmentation() превышает threshold. Возвращает true, если Compact() был вызван.
+    // Удобно вызывать после пачки изменений: проверка стоит одного прохода по списку
+    bool CompactIfFragmented(double threshold = 0.5) {
+        if (GetFragmentation() <= threshold) {
+            return false; 
+        }
+        Compact(); 
+        return true; 
     }
 
 private:
 
-    // темплейтный филлер по итератору - для списка инициализации и для конструктора копирования
-    template <typename SourceIterator>
-    void FillWithValues(SourceIterator begin_, SourceIterator end_) {
-        // пытаемся построить временный список, в процессе все может сломаться
+    // Цепочка узлов, отцепленных от списка. Узлы освобождаются все разом в деструкторе
+    struct RemovedChain {
+        explicit RemovedChain(SingleLinkedList& list) noexcept : owner(list) {}
+        RemovedChain(const RemovedChain&) = delete; 
+        RemovedChain& operator=(const RemovedChain&) = delete; 
+
+        ~RemovedChain() {
+            if (count) {
+                owner.OnRelink(); 
+            }
+            owner.size_ -= count; 
+            owner.stats_.OnResize(owner.size_); 
+            while (first) {
+                owner.DestroyNode(std::exchange(first, first->next_node)); 
+            }
+        }
+
+        // Отцепляет узел, следующий за prev
+        void Take(NodeBase* prev) noexcept {
+            Node* node = prev->next_node; 
+            prev->next_node = node->next_node; 
+            if (node == owner.tail_) {
+                owner.tail_ = prev; 
+            }
+            node->next_node = first; 
+            first = node; 
+            ++count; 
+        }
+
+        SingleLinkedList& owner; 
+        Node* first = nullptr; 
+        size_t count = 0; 
+    };
+
+    // Сливает отсортированную цепочку newer в отсортированную цепочку target, результат — в target.
+    // При равенстве первыми идут узлы target, поэтому слияние устойчиво.
+    // Если comp бросит исключение, target всё равно будет содержать все узлы обеих цепочек
+    template <typename Compare>
+    static void MergeChains(Node*& target, Node* newer, Compare& comp) {
+        NodeBase merged; 
+        NodeBase* tail = &merged; 
+        Node* older = target; 
         try {
-            SingleLinkedList temp;
-            Node* last_node = temp.head_; 
-            for (auto it = begin_; it != end_; ++it) {
-                last_node->next_node = new Node(*it, nullptr); 
-                last_node = last_node->next_node;  
-                ++temp.size_; 
-            } 
-            
-            // если ничего не сломалось, записываем его в основной
-            swap(temp); 
+            while (older && newer) {
+                if (comp(std::as_const(newer->value), std::as_const(older->value))) {
+                    tail->next_node = newer; 
+                    newer = newer->next_node; 
+                } else {
+                    tail->next_node = older; 
+                    older = older->next_node; 
+                }
+                tail = tail->next_node; 
+            }
         } catch (...) {
-            throw;
-        }   
+            tail->next_node = older; 
+            LastNode(tail)->next_node = newer; 
+            target = merged.next_node; 
+            throw; 
+        }
+        tail->next_node = older ? older : newer; 
+        target = merged.next_node; 
+    }
+
+    // Память под ещё не сконструированный узел. Пока узел не построен, в ней хранится ссылка на следующий такой слот
+    struct FreeSlot {
+        FreeSlot* next; 
+    };
+
+    // Выделяет память под count узлов, не конструируя их, и связывает слоты в цепочку в порядке адресов.
+    // При исключении уже выделенная память возвращается аллокатору
+    FreeSlot* AllocateSlots(size_t count) {
+        static_assert(sizeof(Node) >= sizeof(FreeSlot)); 
+        FreeSlot* first = nullptr; 
+        if constexpr (AllowsPartialDeallocation<NodeAllocator>(0)) {
+            Node* block = NodeTraits::allocate(alloc_, count); 
+            for (size_t i = count; i-- > 0;) {
+                first = ::new (static_cast<void*>(block + i)) FreeSlot{first}; 
+            }
+        } else {
+            FreeSlot** last = &first; 
+            try {
+                for (size_t i = 0; i < count; ++i) {
+                    *last = ::new (static_cast<void*>(NodeTraits::allocate(alloc_, 1))) FreeSlot{nullptr}; 
+                    last = &(*last)->next; 
+                }
+            } catch (...) {
+                ReleaseSlots(first); 
+                throw; 
+            }
+        }
+        return first; 
+    }
+
+    void ReleaseSlots(FreeSlot* slots) noexcept {
+        while (slots) {
+            NodeTraits::deallocate(alloc_, reinterpret_cast<Node*>(std::exchange(slots, slots->next)), 1); 
+        }
+    }
+
+    // Копирующее присваивание, которое не пересоздаёт узлы: значения rhs присваиваются в уже имеющиеся узлы,
+    // недостающие узлы создаются заранее, до изменения списка, а лишние освобождаются.
+    // Присваивание Type не бросает исключений, поэтому строгая гарантия сохраняется.
+    // При равных размерах обходится без аллокаций и освобождений
+    void AssignReusingNodes(const SingleLinkedList& rhs) {
+        const size_t reused = std::min(size_, rhs.size_); 
+        ConstIterator source = rhs.begin(); 
+        for (size_t i = 0; i < reused; ++i) {
+            ++source; 
+        }
+        const Chain extra = CreateChain(source, rhs.end()); 
+
+        NodeBase* prev = &head_; 
+        for (auto it = rhs.begin(); it != source; ++it) {
+            prev->next_node->value = *it; 
+            prev = prev->next_node; 
+        }
+        if (prev->next_node) {
+            OnRelink(); 
+            DestroyChain(std::exchange(prev->next_node, nullptr)); 
+        }
+        size_ = reused; 
+        tail_ = prev; 
+        stats_.OnResize(size_); 
+        LinkChain(prev, extra); 
+    }
+
+    // Цепочка узлов, ещё не связанная со списком
+    struct Chain {
+        Node* first = nullptr; 
+        Node* last = nullptr; 
+        size_t count = 0; 
+    };
+
+    // Создаёт цепочку узлов со значениями из [first, last), не трогая список.
+    // При исключении созданные узлы освобождаются
+    template <typename InputIterator>
+    Chain CreateChain(InputIterator first, InputIterator last) {
+        NodeBase head; 
+        NodeBase* tail = &head; 
+        size_t count = 0; 
+        try {
+            for (; first != last; ++first, ++count) {
+                tail->next_node = CreateNode(nullptr, *first); 
+                tail = tail->next_node; 
+            }
+        } catch (...) {
+            DestroyChain(head.next_node); 
+            throw; 
+        }
+        return Chain{head.next_node, count ? static_cast<Node*>(tail) : nullptr, count}; 
+    }
+
+    // Вставляет цепочку после pos. Возвращает итератор на её последний узел (pos, если цепочка пуста)
+    Iterator LinkChain(NodeBase* pos, const Chain& chain) noexcept {
+        if (!chain.first) {
+            return Iterator(pos, &stats_); 
+        }
+        chain.last->next_node = pos->next_node; 
+        pos->next_node = chain.first; 
+        if (pos == tail_) {
+            tail_ = chain.last; 
+        }
+        size_ += chain.count; 
+        stats_.OnInsert(); 
+        stats_.OnResize(size_); 
+        return Iterator(chain.last, &stats_); 
+    }
+
+    void DestroyChain(Node* first) noexcept {
+        while (first) {
+            DestroyNode(std::exchange(first, first->next_node)); 
+        }
+    }
+
+    // Уничтожает цепочку, отданную ListReclaimer в ClearDeferred. Аллокатор без состояния,
+    // поэтому память узлов может освободить любой его экземпляр
+    static void ReclaimChain(void* chain, void* /*context*/) noexcept {
+        NodeAllocator alloc; 
+        Node* node = static_cast<Node*>(chain); 
+        while (node) {
+            Node* next = node->next_node; 
+            NodeTraits::destroy(alloc, node); 
+            NodeTraits::deallocate(alloc, node, 1); 
+            node = next; 
+        }
+    }
+
+    // На сколько узлов вперёд VisitNodes запрашивает узлы в кеш
+    static constexpr size_t kPrefetchDistance = 8; 
+
+    // Подсказка процессору загрузить узел в кеш. На компиляторах без __builtin_prefetch ничего не делает
+    static void PrefetchNode(const NodeBase* node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(node); 
+#else
+        (void)node; 
+#endif
+    }
+
+    // Обходит узлы начиная с first, пока visit(node) возвращает true; возвращает узел, на котором обход остановился
+    // (nullptr, если дошёл до конца). Второй указатель идёт на kPrefetchDistance узлов впереди и запрашивает их,
+    // поэтому загрузки следующих узлов идут вместе с обработкой текущих, а не начинаются лишь при переходе к ним
+    template <typename Visitor>
+    static Node* VisitNodes(Node* first, Visitor&& visit) {
+        Node* ahead = first; 
+        for (size_t i = 0; i < kPrefetchDistance && ahead; ++i) {
+            PrefetchNode(ahead); 
+            ahead = ahead->next_node; 
+        }
+        for (Node* node = first; node; node = node->next_node) {
+            if (ahead) {
+                PrefetchNode(ahead); 
+                ahead = ahead->next_node; 
+            }
+            if (!visit(node)) {
+                return node; 
+            }
+        }
+        return nullptr; 
+    }
+
+    Node* FindNode(const Type& value) const {
+        return VisitNodes(head_.next_node, [&value](Node* node) {
+            return !(std::as_const(node->value) == value); 
+        }); 
+    }
+
+    // Последний узел цепочки, начинающейся с from (сам from, если за ним ничего нет)
+    static NodeBase* LastNode(NodeBase* from) noexcept {
+        while (from->next_node) {
+            from = from->next_node; 
+        }
+        return from; 
+    }
+
+    // Выделяет и конструирует узел. Если конструктор Type бросит исключение, память вернётся аллокатору
+    template <typename... Args>
+    Node* CreateNode(Node* next, Args&&... args) {
+        Node* node = NodeTraits::allocate(alloc_, 1); 
+        stats_.OnAllocate(); 
+        try {
+            NodeTraits::construct(alloc_, node, next, std::forward<Args>(args)...); 
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1); 
+            stats_.OnDeallocate(); 
+            throw; 
+        }
+        return node; 
+    }
+
+    void DestroyNode(Node* node) noexcept {
+        NodeTraits::destroy(alloc_, node); 
+        NodeTraits::deallocate(alloc_, node, 1); 
+        stats_.OnDeallocate(); 
+    }
+
+    // Забирает цепочку узлов other. Аллокаторы должны быть равны
+    void StealNodes(SingleLinkedList& other) noexcept {
+        OnRelink(); 
+        other.OnRelink(); 
+        head_.next_node = std::exchange(other.head_.next_node, nullptr); 
+        tail_ = std::exchange(other.tail_, &other.head_); 
+        size_ = std::exchange(other.size_, 0); 
+        stats_.Swap(other.stats_); 
+        stats_.OnResize(size_); 
+        other.stats_.OnResize(0); 
+        FixEmptyTail(); 
+    }
+
+    void FixEmptyTail() noexcept {
+        if (!head_.next_node) {
+            tail_ = &head_; 
+        }
+    }
+
+    // Узлы уходят из списка или меняют порядок, см. GetStructureVersion()
+    void OnRelink() noexcept {
+        structure_version_ = NextStructureVersion(); 
+    }
+
+    // Версии уникальны для всех списков этого типа: список, созданный заново по адресу уничтоженного,
+    // не получит ни одной из его версий, и ListCheckpoints не примет старые узлы за его.
+    // Каждый поток берёт у общего счётчика сразу пачку номеров, чтобы EraseAfter в разных потоках не боролись за него
+    static size_t NextStructureVersion() noexcept {
+        static constexpr size_t kBatch = 1024; 
+        static std::atomic<size_t> next_batch{1}; 
+        thread_local size_t next = 0; 
+        thread_local size_t batch_end = 0; 
+        if (next == batch_end) {
+            next = next_batch.fetch_add(kBatch, std::memory_order_relaxed); 
+            batch_end = next + kBatch; 
+        }
+        return next++; 
+    }
+
+    // Есть ли у аллокатора массовое освобождение TryReleaseAll (см. PoolAllocator)
+    template <typename NodeAlloc>
+    static constexpr auto HasBulkRelease(int) -> decltype(std::declval<NodeAlloc&>().TryReleaseAll(size_t{}), bool()) {
+        return true; 
+    }
+    template <typename NodeAlloc>
+    static constexpr bool HasBulkRelease(...) {
+        return false; 
+    }
+
+    // Можно ли вернуть по одному узлу память, выделенную одним allocate(n) (см. PoolAllocator)
+    template <typename NodeAlloc>
+    static constexpr auto AllowsPartialDeallocation(int) -> decltype(NodeAlloc::allows_partial_deallocation::value, bool()) {
+        return NodeAlloc::allows_partial_deallocation::value; 
+    }
+    template <typename NodeAlloc>
+    static constexpr bool AllowsPartialDeallocation(...) {
+        return false; 
+    }
+
+    // Заполняет пустой список значениями из [first, last) (для конструкторов).
+    // Узлы создаются отдельной цепочкой, см. CreateChain; если что-то сломается, список останется пустым
+    template <typename SourceIterator>
+    void FillWithValues(SourceIterator first, SourceIterator last) {
+        LinkChain(&head_, CreateChain(first, last)); 
     }
 
     // Фиктивный узел, используется для вставки "перед первым элементом"
-    Node *head_;
+    NodeBase head_;
+    // Последний узел; у пустого списка — &head_
+    NodeBase* tail_ = &head_;
     size_t size_ = 0;
+    size_t structure_version_ = NextStructureVersion();
+    NodeAllocator alloc_;
+    // Не копируется и не перемещается вместе с элементами: у каждого объекта списка своя статистика
+    [[no_unique_address]] Stats stats_{sizeof(Node), ListTypeTag<SingleLinkedList>{}};
 };
 
-
+// Список, берущий память из std::pmr::memory_resource (например, NodePoolResource из pool_allocator.h)
 template <typename Type>
-void swap(SingleLinkedList<Type>& lhs, SingleLinkedList<Type>& rhs) noexcept {
+using PmrSingleLinkedList = SingleLinkedList<Type, std::pmr::polymorphic_allocator<Type>>;
+
+
+template <typename Type, typename Allocator, typename Stats>
+void swap(SingleLinkedList<Type, Allocator, Stats>& lhs, SingleLinkedList<Type, Allocator, Stats>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
-template <typename Type>
-bool operator==(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Stats>
+bool operator==(const SingleLinkedList<Type, Allocator, Stats>& lhs, const SingleLinkedList<Type, Allocator, Stats>& rhs) {
     // сравниваем размеры
     if (lhs.GetSize() != rhs.GetSize()) {
         return false;
@@ -280,29 +1239,29 @@ bool operator==(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>&
     return true;
 }
 
-template <typename Type>
-bool operator!=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Stats>
+bool operator!=(const SingleLinkedList<Type, Allocator, Stats>& lhs, const SingleLinkedList<Type, Allocator, Stats>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-bool operator<(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Stats>
+bool operator<(const SingleLinkedList<Type, Allocator, Stats>& lhs, const SingleLinkedList<Type, Allocator, Stats>& rhs) {
     return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), 
                                         rhs.cbegin(), rhs.cend());
 }
 
-template <typename Type>
-bool operator<=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Stats>
+bool operator<=(const SingleLinkedList<Type, Allocator, Stats>& lhs, const SingleLinkedList<Type, Allocator, Stats>& rhs) {
     return (lhs < rhs) || (lhs == rhs);
 }
 
-template <typename Type>
-bool operator>(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Stats>
+bool operator>(const SingleLinkedList<Type, Allocator, Stats>& lhs, const SingleLinkedList<Type, Allocator, Stats>& rhs) {
     return !(lhs <= rhs);
 }
 
-template <typename Type>
-bool operator>=(const SingleLinkedList<Type>& lhs, const SingleLinkedList<Type>& rhs) {
+template <typename Type, typename Allocator, typename Stats>
+bool operator>=(const SingleLinkedList<Type, Allocator, Stats>& lhs, const SingleLinkedList<Type, Allocator, Stats>& rhs) {
     return !(lhs < rhs);
 } 
 
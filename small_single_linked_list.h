@@ -0,0 +1,276 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "single_linked_list.h"
+
+// Буфер на N слотов размером SlotSize, расположенный прямо в объекте владельца.
+// Слоты выдаются сначала подряд, а освобождённые — повторно через free list
+template <size_t SlotSize, size_t SlotAlign, size_t N>
+class InlineNodeArena {
+public:
+    static constexpr size_t kSlotSize = SlotSize;
+    static constexpr size_t kSlotAlign = SlotAlign;
+
+    InlineNodeArena() = default;
+    InlineNodeArena(const InlineNodeArena&) = delete;
+    InlineNodeArena& operator=(const InlineNodeArena&) = delete;
+
+    // Возвращает nullptr, если свободных слотов нет
+    [[nodiscard]] void* TryAllocate() noexcept {
+        if (free_list_) {
+            return std::exchange(free_list_, free_list_->next);
+        }
+        if (used_ < N) {
+            return storage_ + SlotSize * used_++;
+        }
+        return nullptr;
+    }
+
+    void Deallocate(void* p) noexcept {
+        free_list_ = ::new (p) FreeSlot{free_list_};
+    }
+
+    [[nodiscard]] bool Owns(const void* p) const noexcept {
+        // std::less даёт полный порядок и для указателей на разные объекты
+        return !std::less<const void*>()(p, storage_) && std::less<const void*>()(p, storage_ + sizeof(storage_));
+    }
+
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static_assert(SlotSize >= sizeof(FreeSlot) && SlotAlign >= alignof(FreeSlot));
+
+    alignas(SlotAlign) unsigned char storage_[SlotSize * N];
+    size_t used_ = 0;
+    FreeSlot* free_list_ = nullptr;
+};
+
+
+// Аллокатор, берущий одиночные объекты из InlineNodeArena, пока в ней есть место, а остальное — из кучи.
+// Привязан к конкретному буферу, поэтому копии аллокатора равны, только если указывают на один буфер,
+// и при присваивании и обмене контейнеров он не распространяется
+template <typename T, typename Arena>
+class InlineArenaAllocator {
+    template <typename, typename>
+    friend class InlineArenaAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    explicit InlineArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+
+    template <typename U>
+    InlineArenaAllocator(const InlineArenaAllocator<U, Arena>& other) noexcept : arena_(other.arena_) {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if constexpr (sizeof(T) <= Arena::kSlotSize && alignof(T) <= Arena::kSlotAlign) {
+            if (n == 1) {
+                if (void* p = arena_->TryAllocate()) {
+                    return static_cast<T*>(p);
+                }
+            }
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (arena_->Owns(p)) {
+            arena_->Deallocate(p);
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const InlineArenaAllocator<U, Arena>& rhs) const noexcept {
+        return arena_ == rhs.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const InlineArenaAllocator<U, Arena>& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    Arena* arena_;
+};
+
+
+namespace small_list_detail {
+
+// Раскладка узла SingleLinkedList: указатель на следующий узел и значение
+template <typename Type>
+struct NodeLayout {
+    void* next_node;
+    Type value;
+};
+
+template <typename Type, size_t N>
+using Arena = InlineNodeArena<sizeof(NodeLayout<Type>), alignof(NodeLayout<Type>), N>;
+
+// Буфер — отдельная база, чтобы он был построен раньше списка и разрушен после него
+template <typename Type, size_t N>
+struct ArenaHolder {
+    Arena<Type, N> arena_;
+};
+
+}  // namespace small_list_detail
+
+
+// Односвязный список, первые N узлов которого лежат в самом объекте списка.
+// Пока в списке не больше N элементов (считая освобождённые места, которые переиспользуются), он не обращается к куче;
+// дальнейшие узлы выделяются в куче. Итераторы, before_begin(), InsertAfter/EraseAfter и остальные
+// операции над одним списком ведут себя так же, как у SingleLinkedList.
+// Отличия от SingleLinkedList: узлы нельзя переносить между списками (нет SpliceAfter, SplitAfter, Merge, Append),
+// перемещение и обмен работают поэлементно за O(n) и инвалидируют итераторы,
+// а присваивание даёт только базовую гарантию: при исключении список может оказаться частично заполненным
+template <typename Type, size_t N = 8>
+class SmallSingleLinkedList
+    : private small_list_detail::ArenaHolder<Type, N>
+    , private SingleLinkedList<Type, InlineArenaAllocator<Type, small_list_detail::Arena<Type, N>>> {
+    using Allocator = InlineArenaAllocator<Type, small_list_detail::Arena<Type, N>>;
+    using List = SingleLinkedList<Type, Allocator>;
+
+public:
+    using typename List::value_type;
+    using typename List::reference;
+    using typename List::const_reference;
+    using typename List::Iterator;
+    using typename List::ConstIterator;
+
+    // Сколько узлов помещается в самом объекте списка
+    static constexpr size_t kInlineCapacity = N;
+
+    using List::begin;
+    using List::cbegin;
+    using List::end;
+    using List::cend;
+    using List::before_begin;
+    using List::cbefore_begin;
+    using List::before_end;
+    using List::cbefore_end;
+
+    using List::GetSize;
+    using List::IsEmpty;
+    using List::GetStats;
+    using List::GetStructureVersion;
+    using List::PushFront;
+    using List::EmplaceFront;
+    using List::PushBack;
+    using List::EmplaceBack;
+    using List::front;
+    using List::back;
+    using List::Clear;
+    using List::Assign;
+    using List::InsertAfter;
+    using List::EmplaceAfter;
+    using List::PopFront;
+    using List::EraseAfter;
+    using List::Sort;
+    using List::RemoveIf;
+    using List::Remove;
+    using List::Unique;
+
+    SmallSingleLinkedList() noexcept : List(Allocator(&this->arena_)) {}
+
+    SmallSingleLinkedList(std::initializer_list<Type> values) : List(values, Allocator(&this->arena_)) {}
+
+    SmallSingleLinkedList(const SmallSingleLinkedList& other) : List(other.AsList(), Allocator(&this->arena_)) {}
+
+    // Значения перемещаются поэлементно, other остаётся пустым
+    SmallSingleLinkedList(SmallSingleLinkedList&& other) : List(std::move(other.AsList()), Allocator(&this->arena_)) {
+        other.Clear();
+    }
+
+    SmallSingleLinkedList& operator=(const SmallSingleLinkedList& rhs) {
+        if (this != &rhs) {
+            // Сначала освобождаем свои узлы, чтобы копии заняли места в буфере, а не в куче
+            Clear();
+            for (const Type& value : rhs) {
+                EmplaceBack(value);
+            }
+        }
+        return *this;
+    }
+
+    SmallSingleLinkedList& operator=(SmallSingleLinkedList&& rhs) {
+        if (this != &rhs) {
+            Clear();
+            for (Type& value : rhs) {
+                EmplaceBack(std::move(value));
+            }
+            rhs.Clear();
+        }
+        return *this;
+    }
+
+    // Обменивает содержимое поэлементно за O(n)
+    void swap(SmallSingleLinkedList& other) {
+        if (this != &other) {
+            SmallSingleLinkedList temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+    }
+
+    // Лежит ли узел элемента в самом объекте списка (для диагностики)
+    [[nodiscard]] bool IsInline(ConstIterator pos) const noexcept {
+        return this->arena_.Owns(&*pos);
+    }
+
+private:
+    List& AsList() noexcept {
+        return *this;
+    }
+
+    const List& AsList() const noexcept {
+        return *this;
+    }
+};
+
+
+template <typename Type, size_t N>
+void swap(SmallSingleLinkedList<Type, N>& lhs, SmallSingleLinkedList<Type, N>& rhs) {
+    lhs.swap(rhs);
+}
+
+template <typename Type, size_t N>
+bool operator==(const SmallSingleLinkedList<Type, N>& lhs, const SmallSingleLinkedList<Type, N>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t N>
+bool operator!=(const SmallSingleLinkedList<Type, N>& lhs, const SmallSingleLinkedList<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+bool operator<(const SmallSingleLinkedList<Type, N>& lhs, const SmallSingleLinkedList<Type, N>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t N>
+bool operator<=(const SmallSingleLinkedList<Type, N>& lhs, const SmallSingleLinkedList<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+bool operator>(const SmallSingleLinkedList<Type, N>& lhs, const SmallSingleLinkedList<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+bool operator>=(const SmallSingleLinkedList<Type, N>& lhs, const SmallSingleLinkedList<Type, N>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,456 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Упорядоченный односвязный список на основе списка с пропусками (skip list).
+// Каждый узел, кроме обычной ссылки на следующий, с вероятностью 1/4 получает ссылку через несколько узлов,
+// с вероятностью 1/16 — ещё более дальнюю и т. д. Поиск идёт сверху вниз по уровням ссылок, поэтому
+// Insert, Erase, Find и LowerBound занимают в среднем O(log n), а обход по нижнему уровню — обычный проход по списку.
+// Равные элементы допускаются (как в std::multiset); новый элемент встаёт после уже имеющихся равных.
+// Элементы менять нельзя — это нарушило бы порядок, поэтому итератор только константный.
+// Ссылки всех уровней лежат в одном блоке памяти с узлом: одна аллокация на элемент, в среднем 4/3 ссылки на узел.
+// Итераторы и ссылки на элементы остаются валидными до удаления их элемента.
+// Поиск и удаление не бросают исключений, если их не бросает Compare; если сравнение бросит, список останется корректным
+template <typename Type, typename Compare = std::less<Type>>
+class SortedSingleLinkedList {
+    // Вероятность перейти на следующий уровень — 1/4, поэтому 24 уровней хватает на 4^24 элементов
+    static constexpr size_t kMaxHeight = 24;
+
+    // Сравнение вызывается и через константную ссылку (поиск), и через неконстантную (вставка, удаление)
+    static constexpr bool kNothrowCompare = std::is_nothrow_invocable_v<Compare&, const Type&, const Type&>
+                                            && std::is_nothrow_invocable_v<const Compare&, const Type&, const Type&>;
+
+    struct Node {
+        template <typename... Args>
+        explicit Node(size_t node_height, Args&&... args) : height(node_height), value(std::forward<Args>(args)...) {}
+
+        // Ссылки уровней 0..height-1 лежат сразу за узлом в том же блоке памяти
+        Node** Links() noexcept {
+            return std::launder(reinterpret_cast<Node**>(reinterpret_cast<unsigned char*>(this) + sizeof(Node)));
+        }
+
+        Node* const* Links() const noexcept {
+            return const_cast<Node*>(this)->Links();
+        }
+
+        size_t height;
+        const Type value;
+    };
+
+public:
+    class ConstIterator {
+        friend class SortedSingleLinkedList;
+
+        explicit ConstIterator(const Node* node) noexcept : node_(node) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        ConstIterator() = default;
+
+        [[nodiscard]] bool operator==(const ConstIterator& rhs) const noexcept {
+            return node_ == rhs.node_;
+        }
+
+        [[nodiscard]] bool operator!=(const ConstIterator& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        ConstIterator& operator++() noexcept {
+            node_ = node_->Links()[0];
+            return *this;
+        }
+
+        ConstIterator operator++(int) noexcept {
+            ConstIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return node_->value;
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &node_->value;
+        }
+
+    private:
+        const Node* node_ = nullptr;
+    };
+
+    using value_type = Type;
+    using const_reference = const Type&;
+    using Iterator = ConstIterator;
+
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return ConstIterator(head_[0]);
+    }
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return ConstIterator(nullptr);
+    }
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return end();
+    }
+
+public:
+    SortedSingleLinkedList() = default;
+
+    explicit SortedSingleLinkedList(const Compare& comp) : comp_(comp) {}
+
+    SortedSingleLinkedList(std::initializer_list<Type> values, const Compare& comp = Compare()) : comp_(comp) {
+        try {
+            for (const Type& value : values) {
+                Insert(value);
+            }
+        } catch (...) {
+            Clear();
+            throw;
+        }
+    }
+
+    // O(n): узлы копии получают те же высоты, что и в other, и дописываются в конец каждого уровня
+    SortedSingleLinkedList(const SortedSingleLinkedList& other) : comp_(other.comp_), random_state_(other.random_state_) {
+        Node** tails[kMaxHeight];
+        std::fill(std::begin(tails), std::end(tails), static_cast<Node**>(head_));
+        try {
+            for (const Node* source = other.head_[0]; source; source = source->Links()[0]) {
+                Node* node = CreateNode(source->height, source->value);
+                for (size_t level = 0; level < node->height; ++level) {
+                    tails[level][level] = node;
+                    tails[level] = node->Links();
+                }
+                ++size_;
+            }
+        } catch (...) {
+            Clear();
+            throw;
+        }
+        height_ = other.height_;
+    }
+
+    SortedSingleLinkedList(SortedSingleLinkedList&& other) noexcept
+        : comp_(other.comp_), height_(std::exchange(other.height_, 1)), size_(std::exchange(other.size_, 0)), random_state_(other.random_state_) {
+        std::copy(std::begin(other.head_), std::end(other.head_), std::begin(head_));
+        std::fill(std::begin(other.head_), std::end(other.head_), nullptr);
+    }
+
+    SortedSingleLinkedList& operator=(const SortedSingleLinkedList& rhs) {
+        if (this != &rhs) {
+            SortedSingleLinkedList copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SortedSingleLinkedList& operator=(SortedSingleLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            SortedSingleLinkedList temp(std::move(rhs));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    ~SortedSingleLinkedList() {
+        Clear();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Наименьший элемент
+    [[nodiscard]] const_reference front() const noexcept {
+        assert(!IsEmpty());
+        return head_[0]->value;
+    }
+
+    // Вставляет элемент на его место по порядку за O(log n) в среднем. Возвращает итератор на него.
+    // Если конструктор элемента бросит исключение, список не изменится
+    ConstIterator Insert(const Type& value) {
+        return Emplace(value);
+    }
+
+    ConstIterator Insert(Type&& value) {
+        return Emplace(std::move(value));
+    }
+
+    template <typename... Args>
+    ConstIterator Emplace(Args&&... args) {
+        // Сначала узел: аргументы могут ссылаться на элементы списка, а положение определяется готовым значением
+        Node* node = CreateNode(RandomHeight(), std::forward<Args>(args)...);
+        Node** path[kMaxHeight];
+        try {
+            // Проходим равные элементы, чтобы новый встал после них
+            FindPath(path, [this, &value = node->value](const Type& other) { return !comp_(value, other); });
+        } catch (...) {
+            DestroyNode(node);
+            throw;
+        }
+        for (size_t level = height_; level < node->height; ++level) {
+            path[level] = head_;
+        }
+        height_ = std::max(height_, node->height);
+        for (size_t level = 0; level < node->height; ++level) {
+            node->Links()[level] = path[level][level];
+            path[level][level] = node;
+        }
+        ++size_;
+        return ConstIterator(node);
+    }
+
+    // Удаляет элемент pos. Возвращает итератор на следующий
+    ConstIterator Erase(ConstIterator pos) noexcept(kNothrowCompare) {
+        assert(pos != end());
+        Node* target = const_cast<Node*>(pos.node_);
+        Node** path[kMaxHeight];
+        Node** links = head_;
+        for (size_t level = height_; level-- > 0;) {
+            while (links[level] && comp_(links[level]->value, target->value)) {
+                links = links[level]->Links();
+            }
+            // Среди равных ищем именно target: на уровнях ниже его высоты он встретится
+            if (level < target->height) {
+                while (links[level] != target) {
+                    links = links[level]->Links();
+                }
+            }
+            path[level] = links;
+        }
+        Node* next = target->Links()[0];
+        Detach(path, target);
+        DestroyNode(target);
+        return ConstIterator(next);
+    }
+
+    // Удаляет все элементы, равные value. Возвращает их число.
+    // value может быть ссылкой на элемент этого же списка.
+    // Если сравнение бросит исключение, уже найденные элементы останутся удалёнными
+    size_t Erase(const Type& value) noexcept(kNothrowCompare) {
+        Node** path[kMaxHeight];
+        FindPath(path, [this, &value](const Type& other) { return comp_(other, value); });
+        size_t erased = 0;
+        // Узел, в котором лежит сам value, уничтожается последним
+        Node* holder = nullptr;
+        // Путь к первому равному годится и для следующих: всё, что стояло между ними, уже удалено
+        try {
+            for (Node* node = path[0][0]; node && !comp_(value, node->value); node = path[0][0]) {
+                Detach(path, node);
+                if (&node->value == &value) {
+                    holder = node;
+                } else {
+                    DestroyNode(node);
+                }
+                ++erased;
+            }
+        } catch (...) {
+            if (holder) {
+                DestroyNode(holder);
+            }
+            throw;
+        }
+        if (holder) {
+            DestroyNode(holder);
+        }
+        return erased;
+    }
+
+    // Первый элемент, не меньший value
+    [[nodiscard]] ConstIterator LowerBound(const Type& value) const noexcept(kNothrowCompare) {
+        return ConstIterator(Descend([this, &value](const Type& other) { return comp_(other, value); }));
+    }
+
+    // Первый элемент, больший value
+    [[nodiscard]] ConstIterator UpperBound(const Type& value) const noexcept(kNothrowCompare) {
+        return ConstIterator(Descend([this, &value](const Type& other) { return !comp_(value, other); }));
+    }
+
+    // Первый элемент, равный value, либо end()
+    [[nodiscard]] ConstIterator Find(const Type& value) const noexcept(kNothrowCompare) {
+        const ConstIterator found = LowerBound(value);
+        return found != end() && !comp_(value, *found) ? found : end();
+    }
+
+    [[nodiscard]] bool Contains(const Type& value) const noexcept(kNothrowCompare) {
+        return Find(value) != end();
+    }
+
+    [[nodiscard]] size_t Count(const Type& value) const noexcept(kNothrowCompare) {
+        size_t count = 0;
+        for (ConstIterator it = LowerBound(value); it != end() && !comp_(value, *it); ++it) {
+            ++count;
+        }
+        return count;
+    }
+
+    void Clear() noexcept {
+        for (Node* node = head_[0]; node;) {
+            DestroyNode(std::exchange(node, node->Links()[0]));
+        }
+        std::fill(std::begin(head_), std::end(head_), nullptr);
+        height_ = 1;
+        size_ = 0;
+    }
+
+    void swap(SortedSingleLinkedList& other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(comp_, other.comp_);
+        std::swap(height_, other.height_);
+        std::swap(size_, other.size_);
+        std::swap(random_state_, other.random_state_);
+    }
+
+private:
+    // Спуск по уровням: на каждом идём вперёд, пока before(следующий элемент).
+    // В path[level] — ссылки узла (или головы), после которого на этом уровне стоит первый элемент, для которого before ложно
+    template <typename Before>
+    void FindPath(Node** (&path)[kMaxHeight], Before&& before) noexcept(kNothrowCompare) {
+        Node** links = head_;
+        for (size_t level = height_; level-- > 0;) {
+            while (links[level] && before(links[level]->value)) {
+                links = links[level]->Links();
+            }
+            path[level] = links;
+        }
+    }
+
+    // Первый узел, для которого before ложно, либо nullptr
+    template <typename Before>
+    Node* Descend(Before&& before) const noexcept(kNothrowCompare) {
+        Node* const* links = head_;
+        for (size_t level = height_; level-- > 0;) {
+            while (links[level] && before(links[level]->value)) {
+                links = links[level]->Links();
+            }
+        }
+        return links[0];
+    }
+
+    // Исключает узел, стоящий сразу после path[level] на каждом из своих уровней. Узел не уничтожается
+    void Detach(Node** (&path)[kMaxHeight], Node* node) noexcept {
+        for (size_t level = 0; level < node->height; ++level) {
+            assert(path[level][level] == node);
+            path[level][level] = node->Links()[level];
+        }
+        --size_;
+        while (height_ > 1 && !head_[height_ - 1]) {
+            --height_;
+        }
+    }
+
+    // Высота нового узла: 1 с вероятностью 3/4, 2 — 3/16 и т. д.
+    size_t RandomHeight() noexcept {
+        // xorshift64*: сам список генератор не разделяет ни с кем, поэтому его состояние — просто поле
+        random_state_ ^= random_state_ >> 12;
+        random_state_ ^= random_state_ << 25;
+        random_state_ ^= random_state_ >> 27;
+        uint64_t bits = random_state_ * 2685821657736338717ULL;
+        size_t height = 1;
+        while (height < kMaxHeight && (bits & 3) == 0) {
+            ++height;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    template <typename... Args>
+    static Node* CreateNode(size_t height, Args&&... args) {
+        static_assert(alignof(Node) >= alignof(Node*));
+        void* raw = Allocate(sizeof(Node) + height * sizeof(Node*));
+        Node* node = nullptr;
+        try {
+            node = new (raw) Node(height, std::forward<Args>(args)...);
+        } catch (...) {
+            Deallocate(raw);
+            throw;
+        }
+        std::uninitialized_value_construct_n(reinterpret_cast<Node**>(static_cast<unsigned char*>(raw) + sizeof(Node)), height);
+        return node;
+    }
+
+    static void DestroyNode(Node* node) noexcept {
+        node->~Node();
+        Deallocate(node);
+    }
+
+    static void* Allocate(size_t bytes) {
+        if constexpr (alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t{alignof(Node)});
+        } else {
+            return ::operator new(bytes);
+        }
+    }
+
+    static void Deallocate(void* raw) noexcept {
+        if constexpr (alignof(Node) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(raw, std::align_val_t{alignof(Node)});
+        } else {
+            ::operator delete(raw);
+        }
+    }
+
+    // Ссылки «узла перед первым» на всех уровнях
+    Node* head_[kMaxHeight] = {};
+    [[no_unique_address]] Compare comp_;
+    // Число используемых уровней (не меньше 1)
+    size_t height_ = 1;
+    size_t size_ = 0;
+    uint64_t random_state_ = 0x9E3779B97F4A7C15ULL;
+};
+
+
+template <typename Type, typename Compare>
+void swap(SortedSingleLinkedList<Type, Compare>& lhs, SortedSingleLinkedList<Type, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, typename Compare>
+bool operator==(const SortedSingleLinkedList<Type, Compare>& lhs, const SortedSingleLinkedList<Type, Compare>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, typename Compare>
+bool operator!=(const SortedSingleLinkedList<Type, Compare>& lhs, const SortedSingleLinkedList<Type, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Compare>
+bool operator<(const SortedSingleLinkedList<Type, Compare>& lhs, const SortedSingleLinkedList<Type, Compare>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, typename Compare>
+bool operator<=(const SortedSingleLinkedList<Type, Compare>& lhs, const SortedSingleLinkedList<Type, Compare>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Compare>
+bool operator>(const SortedSingleLinkedList<Type, Compare>& lhs, const SortedSingleLinkedList<Type, Compare>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Compare>
+bool operator>=(const SortedSingleLinkedList<Type, Compare>& lhs, const SortedSingleLinkedList<Type, Compare>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,204 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Кеш освобождённых узлов своего потока. Узел, отданный в Deallocate, не возвращается в operator delete,
+// а кладётся в free list потока для своего размера (с точностью до alignof(std::max_align_t)), и следующий
+// Allocate того же размера в этом потоке забирает его без обращения к куче. Синхронизации нет: у каждого потока свой кеш.
+// Узел можно освободить в другом потоке, чем выделен: он попадёт в кеш освободившего потока.
+// В каждом free list лежит не больше GetLimit() узлов, лишние сразу уходят в operator delete.
+// При завершении потока его кеш освобождается. Узлы больше kMaxNodeSize байт не кешируются
+class ThreadNodeCache {
+public:
+    struct Stats {
+        // Выделения, обслуженные из кеша
+        size_t hits = 0;
+        // Выделения, ушедшие в operator new
+        size_t misses = 0;
+        // Узлов лежит в кеше сейчас
+        size_t cached = 0;
+    };
+
+    static constexpr size_t kGranularity = alignof(std::max_align_t);
+    static constexpr size_t kMaxNodeSize = 256;
+    static constexpr size_t kDefaultLimit = 4096;
+
+    static constexpr bool IsCacheable(size_t size, size_t alignment) noexcept {
+        return size <= kMaxNodeSize && alignment <= kGranularity;
+    }
+
+    // Узел размером size (IsCacheable) из кеша текущего потока или из operator new
+    static void* Allocate(size_t size) {
+        if (ThreadNodeCache* cache = Local()) {
+            Bucket& bucket = cache->buckets_[ClassOf(size)];
+            if (FreeNode* node = bucket.head) {
+                bucket.head = node->next;
+                --bucket.count;
+                ++cache->hits_;
+                return node;
+            }
+            ++cache->misses_;
+        }
+        // Все узлы одного класса одного размера, чтобы любой из них годился для любого выделения этого класса
+        return ::operator new(RoundUp(size));
+    }
+
+    static void Deallocate(void* p, size_t size) noexcept {
+        ThreadNodeCache* cache = Local();
+        if (!cache) {
+            ::operator delete(p);
+            return;
+        }
+        Bucket& bucket = cache->buckets_[ClassOf(size)];
+        if (bucket.count >= cache->limit_) {
+            ::operator delete(p);
+            return;
+        }
+        bucket.head = ::new (p) FreeNode{bucket.head};
+        ++bucket.count;
+    }
+
+    // Предел числа узлов одного размера в кеше текущего потока. Лишние узлы освобождаются сразу
+    static void SetLimit(size_t nodes) noexcept {
+        if (ThreadNodeCache* cache = Local()) {
+            cache->limit_ = nodes;
+            cache->TrimTo(nodes);
+        }
+    }
+
+    [[nodiscard]] static size_t GetLimit() noexcept {
+        const ThreadNodeCache* cache = Local();
+        return cache ? cache->limit_ : 0;
+    }
+
+    // Предел для потоков, которые ещё не обращались к кешу
+    static void SetDefaultLimit(size_t nodes) noexcept {
+        default_limit_.store(nodes, std::memory_order_relaxed);
+    }
+
+    // Оставляет в кеше текущего потока не больше keep узлов каждого размера, остальные отдаёт в operator delete
+    static void Trim(size_t keep = 0) noexcept {
+        if (ThreadNodeCache* cache = Local()) {
+            cache->TrimTo(keep);
+        }
+    }
+
+    // Счётчики кеша текущего потока
+    [[nodiscard]] static Stats GetStats() noexcept {
+        Stats stats;
+        if (const ThreadNodeCache* cache = Local()) {
+            stats.hits = cache->hits_;
+            stats.misses = cache->misses_;
+            for (const Bucket& bucket : cache->buckets_) {
+                stats.cached += bucket.count;
+            }
+        }
+        return stats;
+    }
+
+    ThreadNodeCache(const ThreadNodeCache&) = delete;
+    ThreadNodeCache& operator=(const ThreadNodeCache&) = delete;
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct Bucket {
+        FreeNode* head = nullptr;
+        size_t count = 0;
+    };
+
+    ThreadNodeCache() noexcept = default;
+
+    ~ThreadNodeCache() {
+        TrimTo(0);
+        Destroyed() = true;
+    }
+
+    // Кеш текущего потока. После его разрушения при завершении потока — nullptr:
+    // узлы, освобождаемые деструкторами других thread_local объектов, идут прямо в operator delete
+    static ThreadNodeCache* Local() noexcept {
+        if (Destroyed()) {
+            return nullptr;
+        }
+        static thread_local ThreadNodeCache cache;
+        return &cache;
+    }
+
+    static bool& Destroyed() noexcept {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    static constexpr size_t RoundUp(size_t size) noexcept {
+        return (size + kGranularity - 1) / kGranularity * kGranularity;
+    }
+
+    static constexpr size_t ClassOf(size_t size) noexcept {
+        return size <= kGranularity ? 0 : RoundUp(size) / kGranularity - 1;
+    }
+
+    void TrimTo(size_t keep) noexcept {
+        for (Bucket& bucket : buckets_) {
+            while (bucket.count > keep) {
+                FreeNode* node = bucket.head;
+                bucket.head = node->next;
+                --bucket.count;
+                ::operator delete(node);
+            }
+        }
+    }
+
+    Bucket buckets_[kMaxNodeSize / kGranularity];
+    size_t limit_ = default_limit_.load(std::memory_order_relaxed);
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    static inline std::atomic<size_t> default_limit_{kDefaultLimit};
+};
+
+// Аллокатор узлов через ThreadNodeCache: подключается к списку параметром шаблона,
+// SingleLinkedList<T, ThreadCachingAllocator<T>>. Тогда EraseAfter, PopFront и Clear складывают узлы
+// в кеш своего потока, а PushFront, InsertAfter и другие вставки берут их оттуда.
+// Без состояния: все экземпляры равны, поэтому списки могут обмениваться узлами (Splice, swap)
+template <typename T>
+class ThreadCachingAllocator {
+    static constexpr bool kCacheable = ThreadNodeCache::IsCacheable(sizeof(T), alignof(T));
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    ThreadCachingAllocator() noexcept = default;
+
+    template <typename U>
+    ThreadCachingAllocator(const ThreadCachingAllocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(size_t n) {
+        if (kCacheable && n == 1) {
+            return static_cast<T*>(ThreadNodeCache::Allocate(sizeof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (kCacheable && n == 1) {
+            ThreadNodeCache::Deallocate(p, sizeof(T));
+            return;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const ThreadCachingAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator!=(const ThreadCachingAllocator<U>&) const noexcept {
+        return false;
+    }
+};
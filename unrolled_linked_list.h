@@ -0,0 +1,423 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+// Развёрнутый (unrolled) односвязный список: каждый узел хранит до N элементов в непрерывном массиве.
+// Обход делает один переход по указателю на N элементов, а накладные расходы на указатели в N раз меньше,
+// чем у SingleLinkedList. Интерфейс повторяет SingleLinkedList (before_begin, InsertAfter, EraseAfter, PopFront).
+// Переполненный узел делится пополам, а узел, в котором после удаления осталось меньше N / 2 элементов,
+// забирает элементы у следующего или сливается с ним, поэтому удаления не оставляют полупустых узлов.
+//
+// Инвалидация итераторов: InsertAfter и EraseAfter сдвигают элементы внутри узла,
+// поэтому инвалидируют все итераторы на элементы узла, в который вставляли/из которого удаляли
+// (а при переполнении узла — и на элементы, переехавшие в новый узел; при удалении — и на элементы следующего узла).
+// Итераторы на элементы других узлов, before_begin() и end() остаются валидными.
+// Строгая гарантия при исключениях обеспечивается, если перемещение Type не бросает исключений
+template <typename Type, size_t N = 16>
+class UnrolledLinkedList {
+    static_assert(N >= 2, "node must hold at least two elements");
+
+    struct Node;
+
+    // Часть узла без значений. Фиктивный узел head_ состоит только из неё и всегда пуст
+    struct NodeBase {
+        Node* next_node = nullptr;
+        size_t count = 0;
+    };
+
+    // Узел: count элементов, сконструированных в начале массива storage
+    struct Node : NodeBase {
+        explicit Node(Node* next) : NodeBase{next, 0} {}
+
+        Type* Values() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+
+        alignas(Type) unsigned char storage[sizeof(Type) * N];
+    };
+
+    // Итератор — пара (узел, индекс элемента в узле)
+    // ValueType — совпадает с Type (для Iterator) либо с const Type (для ConstIterator)
+    template <typename ValueType>
+    class BasicIterator {
+        friend class UnrolledLinkedList;
+        template <typename>
+        friend class BasicIterator;
+
+        BasicIterator(NodeBase* node, size_t index) : node_(node), index_(index) {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ValueType*;
+        using reference = ValueType&;
+
+        BasicIterator() = default;
+
+        // При ValueType, совпадающем с const Type, играет роль конвертирующего конструктора
+        BasicIterator(const BasicIterator<Type>& other) noexcept : node_(other.node_), index_(other.index_) {}
+
+        BasicIterator& operator=(const BasicIterator& rhs) = default;
+
+        template <typename OtherValueType>
+        [[nodiscard]] bool operator==(const BasicIterator<OtherValueType>& rhs) const noexcept {
+            return node_ == rhs.node_ && index_ == rhs.index_;
+        }
+
+        template <typename OtherValueType>
+        [[nodiscard]] bool operator!=(const BasicIterator<OtherValueType>& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        // Переход к следующему узлу происходит раз в count элементов.
+        // У before_begin() узел пустой (count == 0), поэтому он сразу переходит к первому узлу
+        BasicIterator& operator++() noexcept {
+            if (++index_ >= node_->count) {
+                node_ = node_->next_node;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old(*this);
+            ++(*this);
+            return old;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return static_cast<Node*>(node_)->Values()[index_];
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept {
+            return &**this;
+        }
+
+    private:
+        NodeBase* node_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = Type;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    // Вместимость одного узла
+    static constexpr size_t kNodeCapacity = N;
+
+    [[nodiscard]] Iterator begin() noexcept {
+        return Iterator(head_.next_node, 0);
+    }
+    [[nodiscard]] ConstIterator cbegin() const noexcept {
+        return Iterator(head_.next_node, 0);
+    }
+    [[nodiscard]] ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    [[nodiscard]] Iterator end() noexcept {
+        return Iterator(nullptr, 0);
+    }
+    [[nodiscard]] ConstIterator cend() const noexcept {
+        return Iterator(nullptr, 0);
+    }
+    [[nodiscard]] ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    [[nodiscard]] Iterator before_begin() noexcept {
+        return Iterator(&head_, 0);
+    }
+    [[nodiscard]] ConstIterator cbefore_begin() const noexcept {
+        return Iterator(const_cast<NodeBase*>(&head_), 0);
+    }
+    [[nodiscard]] ConstIterator before_begin() const noexcept {
+        return cbefore_begin();
+    }
+
+public:
+    UnrolledLinkedList() = default;
+
+    UnrolledLinkedList(std::initializer_list<Type> values) {
+        FillWithValues(values.begin(), values.end());
+    }
+
+    UnrolledLinkedList(const UnrolledLinkedList& other) {
+        FillWithValues(other.begin(), other.end());
+    }
+
+    UnrolledLinkedList(UnrolledLinkedList&& other) noexcept {
+        swap(other);
+    }
+
+    UnrolledLinkedList& operator=(const UnrolledLinkedList& rhs) {
+        if (this != &rhs) {
+            UnrolledLinkedList temp(rhs);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    UnrolledLinkedList& operator=(UnrolledLinkedList&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~UnrolledLinkedList() {
+        Clear();
+    }
+
+    [[nodiscard]] size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    void PushFront(const Type& value) {
+        InsertAfter(before_begin(), value);
+    }
+
+    void PushFront(Type&& value) {
+        InsertAfter(before_begin(), std::move(value));
+    }
+
+    void PopFront() noexcept {
+        EraseAfter(before_begin());
+    }
+
+    void Clear() noexcept {
+        while (head_.next_node) {
+            Node* tmp = head_.next_node;
+            head_.next_node = tmp->next_node;
+            DestroyNode(tmp);
+        }
+        size_ = 0;
+    }
+
+    // Число узлов (для диагностики и тестов), за O(число узлов)
+    [[nodiscard]] size_t GetNodeCount() const noexcept {
+        size_t count = 0;
+        for (const Node* node = head_.next_node; node; node = node->next_node) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Обменивает содержимое списков за O(1)
+    void swap(UnrolledLinkedList& other) noexcept {
+        std::swap(head_.next_node, other.head_.next_node);
+        std::swap(size_, other.size_);
+    }
+
+    // Возвращает итератор на вставленный элемент
+    Iterator InsertAfter(ConstIterator pos, const Type& value) {
+        return EmplaceAfter(pos, value);
+    }
+
+    Iterator InsertAfter(ConstIterator pos, Type&& value) {
+        return EmplaceAfter(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator EmplaceAfter(ConstIterator pos, Args&&... args) {
+        // Сначала конструируем значение: если это бросит исключение, список ещё не тронут
+        Type value(std::forward<Args>(args)...);
+
+        Node* node = nullptr;
+        size_t index = 0;
+        if (pos.node_ == &head_) {
+            // Вставка в начало: в первый узел, если в нём есть место, иначе в новый узел перед ним
+            node = head_.next_node;
+            if (!node || node->count == N) {
+                node = CreateNodeAfter(&head_);
+            }
+        } else {
+            node = static_cast<Node*>(pos.node_);
+            index = pos.index_ + 1;
+            if (node->count == N) {
+                // Узел полон: вторая половина переезжает в новый узел
+                Node* new_node = CreateNodeAfter(node);
+                MoveTail(node, N / 2, new_node);
+                if (index > N / 2) {
+                    node = new_node;
+                    index -= N / 2;
+                }
+            }
+        }
+
+        // Сдвигаем хвост узла на одну позицию вправо и кладём значение на освободившееся место
+        Type* values = node->Values();
+        for (size_t i = node->count; i > index; --i) {
+            new (values + i) Type(std::move(values[i - 1]));
+            values[i - 1].~Type();
+        }
+        new (values + index) Type(std::move(value));
+        ++node->count;
+        ++size_;
+        return Iterator(node, index);
+    }
+
+    // Возвращает итератор на элемент, следующий за удалённым
+    Iterator EraseAfter(ConstIterator pos) noexcept {
+        // Удаляемый элемент лежит либо в том же узле, что и pos, либо первым в следующем узле
+        NodeBase* prev = pos.node_;
+        Node* node = nullptr;
+        size_t index = 0;
+        if (prev != &head_ && pos.index_ + 1 < prev->count) {
+            node = static_cast<Node*>(prev);
+            index = pos.index_ + 1;
+        } else {
+            node = prev->next_node;
+            if (!node) {
+                return end();
+            }
+        }
+
+        Type* values = node->Values();
+        values[index].~Type();
+        for (size_t i = index + 1; i < node->count; ++i) {
+            new (values + i - 1) Type(std::move(values[i]));
+            values[i].~Type();
+        }
+        --node->count;
+        --size_;
+
+        if (node->count == 0) {
+            // Пустой узел может быть только следующим за prev
+            prev->next_node = node->next_node;
+            DestroyNode(node);
+            return Iterator(prev->next_node, 0);
+        }
+        // Следующий за удалённым элемент остаётся на месте index: при слиянии и заёме элементы следующего узла
+        // дописываются в конец этого
+        if (node->count < N / 2 && node->next_node) {
+            RefillFromNext(node);
+            return Iterator(node, index);
+        }
+        if (index == node->count) {
+            return Iterator(node->next_node, 0);
+        }
+        return Iterator(node, index);
+    }
+
+private:
+    Node* CreateNodeAfter(NodeBase* prev) {
+        Node* node = new Node(prev->next_node);
+        prev->next_node = node;
+        return node;
+    }
+
+    void DestroyNode(Node* node) noexcept {
+        Type* values = node->Values();
+        for (size_t i = 0; i < node->count; ++i) {
+            values[i].~Type();
+        }
+        delete node;
+    }
+
+    // Переносит элементы from[first, count) в начало пустого узла to
+    static void MoveTail(Node* from, size_t first, Node* to) noexcept {
+        Type* src = from->Values();
+        Type* dst = to->Values();
+        for (size_t i = first; i < from->count; ++i) {
+            new (dst + i - first) Type(std::move(src[i]));
+            src[i].~Type();
+        }
+        to->count = from->count - first;
+        from->count = first;
+    }
+
+    // Дополняет узел, в котором меньше N / 2 элементов, из следующего: забирает все его элементы, если они помещаются,
+    // иначе — столько, чтобы в обоих узлах стало не меньше N / 2
+    static void RefillFromNext(Node* node) noexcept {
+        Node* next = node->next_node;
+        const size_t take = (node->count + next->count <= N) ? next->count : (next->count - node->count + 1) / 2;
+        Type* dst = node->Values() + node->count;
+        Type* src = next->Values();
+        for (size_t i = 0; i < take; ++i) {
+            new (dst + i) Type(std::move(src[i]));
+            src[i].~Type();
+        }
+        for (size_t i = take; i < next->count; ++i) {
+            new (src + i - take) Type(std::move(src[i]));
+            src[i].~Type();
+        }
+        node->count += take;
+        next->count -= take;
+        if (next->count == 0) {
+            node->next_node = next->next_node;
+            delete next;
+        }
+    }
+
+    // Строит список с полностью заполненными узлами; при исключении *this не меняется
+    template <typename SourceIterator>
+    void FillWithValues(SourceIterator begin_, SourceIterator end_) {
+        UnrolledLinkedList temp;
+        NodeBase* last_node = &temp.head_;
+        for (auto it = begin_; it != end_; ++it) {
+            if (last_node == &temp.head_ || last_node->count == N) {
+                last_node = temp.CreateNodeAfter(last_node);
+            }
+            Node* node = static_cast<Node*>(last_node);
+            new (node->Values() + node->count) Type(*it);
+            ++node->count;
+            ++temp.size_;
+        }
+        swap(temp);
+    }
+
+    NodeBase head_;
+    size_t size_ = 0;
+};
+
+
+template <typename Type, size_t N>
+void swap(UnrolledLinkedList<Type, N>& lhs, UnrolledLinkedList<Type, N>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename Type, size_t N>
+bool operator==(const UnrolledLinkedList<Type, N>& lhs, const UnrolledLinkedList<Type, N>& rhs) {
+    return lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Type, size_t N>
+bool operator!=(const UnrolledLinkedList<Type, N>& lhs, const UnrolledLinkedList<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+bool operator<(const UnrolledLinkedList<Type, N>& lhs, const UnrolledLinkedList<Type, N>& rhs) {
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+template <typename Type, size_t N>
+bool operator<=(const UnrolledLinkedList<Type, N>& lhs, const UnrolledLinkedList<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+bool operator>(const UnrolledLinkedList<Type, N>& lhs, const UnrolledLinkedList<Type, N>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N>
+bool operator>=(const UnrolledLinkedList<Type, N>& lhs, const UnrolledLinkedList<Type, N>& rhs) {
+    return !(lhs < rhs);
+}
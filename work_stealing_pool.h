@@ -0,0 +1,244 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Пул потоков с перехватом работы (work stealing) для параллельных алгоритмов над списками
+// (см. parallel_list_algorithms.h). У каждого потока своя очередь задач: свою он разбирает с конца,
+// а опустев, забирает задачи из начала чужих очередей. Поток, вызвавший ParallelFor, тоже считается
+// участником пула: пока задачи не закончились, он выполняет их сам, поэтому вложенные вызовы
+// ParallelFor из задач не приводят к взаимной блокировке.
+// Потокобезопасен. Деструктор нельзя вызывать, пока выполняется ParallelFor
+class WorkStealingPool {
+public:
+    // threads — число потоков вместе с вызывающим: пул запускает threads - 1 рабочих потоков.
+    // При threads <= 1 рабочих потоков нет, и ParallelFor выполняет задачи по порядку в вызывающем потоке
+    explicit WorkStealingPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
+        : queues_(std::max<size_t>(1, threads)) {
+        for (auto& queue : queues_) {
+            queue = std::make_unique<Queue>();
+        }
+        workers_.reserve(queues_.size() - 1);
+        try {
+            for (size_t index = 1; index < queues_.size(); ++index) {
+                workers_.emplace_back([this, index] { Run(index); });
+            }
+        } catch (...) {
+            Stop();
+            throw;
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        Stop();
+    }
+
+    // Общий для всей программы пул на std::thread::hardware_concurrency() потоков
+    static WorkStealingPool& Default() {
+        static WorkStealingPool pool;
+        return pool;
+    }
+
+    // Число потоков, включая вызывающий
+    [[nodiscard]] size_t GetThreadCount() const noexcept {
+        return queues_.size();
+    }
+
+    // Вызывает task(i) для каждого i из [0, count) и ждёт завершения всех вызовов.
+    // Вызовы идут параллельно и в произвольном порядке. Если какой-то из них бросит исключение,
+    // ещё не начатые вызовы пропускаются, а первое исключение пробрасывается вызывающему
+    template <typename Task>
+    void ParallelFor(size_t count, Task&& task) {
+        if (count == 0) {
+            return;
+        }
+        if (workers_.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+        using TaskType = std::remove_reference_t<Task>;
+        Job job;
+        job.run = [](void* context, size_t index) {
+            (*static_cast<TaskType*>(context))(index);
+        };
+        job.context = const_cast<void*>(static_cast<const void*>(std::addressof(task)));
+        job.remaining.store(count, std::memory_order_relaxed);
+
+        // Задачи раздаются по очередям всех участников, начиная со своей; дальше баланс выравнивает перехват
+        const size_t self = CurrentQueueIndex();
+        size_t pushed = 0;
+        try {
+            for (size_t offset = 0; offset < queues_.size() && pushed < count; ++offset) {
+                Queue& queue = *queues_[(self + offset) % queues_.size()];
+                const size_t share = (count - pushed) / (queues_.size() - offset);
+                std::lock_guard guard(queue.mutex);
+                for (size_t i = 0; i < share; ++i) {
+                    queue.items.push_back(Item{&job, pushed++});
+                }
+            }
+        } catch (...) {
+            // Не поставленные задачи считаются выполненными с ошибкой
+            job.Fail(std::current_exception());
+            job.remaining.fetch_sub(count - pushed, std::memory_order_acq_rel);
+            count = pushed;
+        }
+        {
+            std::lock_guard guard(sleep_mutex_);
+            queued_ += static_cast<std::ptrdiff_t>(count);
+        }
+        has_work_.notify_all();
+
+        // Помогаем, пока есть что выполнять, потом ждём задачи, выполняемые другими потоками
+        while (job.remaining.load(std::memory_order_acquire) != 0 && TryRunOne(self)) {
+        }
+        std::unique_lock lock(job.mutex);
+        job.finished.wait(lock, [&job] { return job.remaining.load(std::memory_order_acquire) == 0; });
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+private:
+    // Один вызов ParallelFor. Живёт на стеке вызывающего потока, пока не завершатся все его задачи
+    struct Job {
+        void Fail(std::exception_ptr exception) noexcept {
+            std::lock_guard guard(mutex);
+            if (!error) {
+                error = std::move(exception);
+            }
+            failed.store(true, std::memory_order_relaxed);
+        }
+
+        void (*run)(void*, size_t) = nullptr;
+        void* context = nullptr;
+        std::atomic<size_t> remaining{0};
+        std::atomic<bool> failed{false};
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+
+    struct Item {
+        Job* job;
+        size_t index;
+    };
+
+    // Отдельная строка кэша на очередь, чтобы потоки не мешали друг другу при захвате мьютексов
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Item> items;
+    };
+
+    // Рабочий поток, обслуживающий очередь текущего потока; у посторонних потоков — нет
+    struct WorkerSlot {
+        const WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static WorkerSlot& CurrentWorker() noexcept {
+        static thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    // Посторонние потоки делят очередь 0
+    size_t CurrentQueueIndex() const noexcept {
+        const WorkerSlot& slot = CurrentWorker();
+        return slot.pool == this ? slot.index : 0;
+    }
+
+    void Run(size_t index) {
+        CurrentWorker() = WorkerSlot{this, index};
+        while (true) {
+            if (TryRunOne(index)) {
+                continue;
+            }
+            std::unique_lock lock(sleep_mutex_);
+            has_work_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ <= 0) {
+                return;
+            }
+        }
+    }
+
+    // Выполняет одну задачу: сначала из конца своей очереди, затем из начала чужих
+    bool TryRunOne(size_t self) {
+        Item item{};
+        if (!TryPop(self, item)) {
+            return false;
+        }
+        {
+            std::lock_guard guard(sleep_mutex_);
+            --queued_;
+        }
+        Job& job = *item.job;
+        if (!job.failed.load(std::memory_order_relaxed)) {
+            try {
+                job.run(job.context, item.index);
+            } catch (...) {
+                job.Fail(std::current_exception());
+            }
+        }
+        // Последний завершившийся будит вызывающего; job нельзя трогать после освобождения мьютекса
+        std::lock_guard guard(job.mutex);
+        if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            job.finished.notify_all();
+        }
+        return true;
+    }
+
+    bool TryPop(size_t self, Item& item) {
+        {
+            Queue& own = *queues_[self];
+            std::lock_guard guard(own.mutex);
+            if (!own.items.empty()) {
+                item = own.items.back();
+                own.items.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            Queue& victim = *queues_[(self + offset) % queues_.size()];
+            std::lock_guard guard(victim.mutex);
+            if (!victim.items.empty()) {
+                item = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Stop() noexcept {
+        {
+            std::lock_guard guard(sleep_mutex_);
+            stopping_ = true;
+        }
+        has_work_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        workers_.clear();
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex sleep_mutex_;
+    std::condition_variable has_work_;
+    // Сколько задач лежит в очередях. Может ненадолго стать отрицательным: задачу уже забрали, а счётчик ещё не увеличен
+    std::ptrdiff_t queued_ = 0;
+    bool stopping_ = false;
+};